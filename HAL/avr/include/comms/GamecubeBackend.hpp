@@ -8,6 +8,8 @@
 
 class GamecubeBackend : public CommunicationBackend {
   public:
+    static constexpr BackendInfo info = { BackendId::GAMECUBE, "GCN" };
+
     GamecubeBackend(
         InputSource **input_sources,
         size_t input_source_count,
@@ -16,6 +18,7 @@ class GamecubeBackend : public CommunicationBackend {
     );
     ~GamecubeBackend();
     void SendReport();
+    const BackendInfo &Info() { return info; }
 
   private:
     CGamecubeConsole *_gamecube;
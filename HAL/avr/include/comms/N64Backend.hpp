@@ -8,6 +8,8 @@
 
 class N64Backend : public CommunicationBackend {
   public:
+    static constexpr BackendInfo info = { BackendId::N64, "N64" };
+
     N64Backend(
         InputSource **input_sources,
         size_t input_source_count,
@@ -15,12 +17,19 @@ class N64Backend : public CommunicationBackend {
         int data_pin
     );
     ~N64Backend();
+    void SetGameMode(ControllerMode *gamemode);
+
+    // Selects the full deflection of the stick sent to the N64, N64_STICK_RANGE by default. Games
+    // tuned for a new OEM stick may want a little more, e.g. 85.
+    void SetStickRange(uint8_t range);
     void SendReport();
+    const BackendInfo &Info() { return info; }
 
   private:
     CN64Console *_n64;
     N64_Data_t _data;
     int _delay;
+    uint8_t _stick_range = N64_STICK_RANGE;
 };
 
 #endif
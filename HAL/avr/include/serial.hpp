@@ -10,6 +10,9 @@ namespace serial {
     void write(uint8_t byte);
     void write(uint8_t *bytes, size_t len);
     int available_for_write();
+    int available();
+    int read();
+    bool connected();
 }
 
 #endif
\ No newline at end of file
@@ -26,6 +26,21 @@ N64Backend::~N64Backend() {
     delete _n64;
 }
 
+void N64Backend::SetGameMode(ControllerMode *gamemode) {
+    // Build the mode's N64 coordinate map now so that polls only need a table lookup.
+    if (gamemode != nullptr) {
+        gamemode->InitN64AxisMap(_stick_range);
+    }
+    CommunicationBackend::SetGameMode(gamemode);
+}
+
+void N64Backend::SetStickRange(uint8_t range) {
+    _stick_range = range;
+    if (_gamemode != nullptr) {
+        _gamemode->InitN64AxisMap(_stick_range);
+    }
+}
+
 void N64Backend::SendReport() {
     // Update inputs from all sources at once.
     ScanInputs();
@@ -50,9 +65,14 @@ void N64Backend::SendReport() {
     _data.report.cdown = _outputs.rightStickY < 128;
     _data.report.cup = _outputs.rightStickY > 128;
 
-    // Analog outputs - converted from unsigned to signed 8-bit integers
-    _data.report.xAxis = _outputs.leftStickX - 128;
-    _data.report.yAxis = _outputs.leftStickY - 128;
+    // Analog outputs - converted to N64 coordinates using the mode's precomputed map
+    if (_gamemode != nullptr) {
+        _data.report.xAxis = _gamemode->N64AxisX(_outputs.leftStickX);
+        _data.report.yAxis = _gamemode->N64AxisY(_outputs.leftStickY);
+    } else {
+        _data.report.xAxis = _outputs.leftStickX - 128;
+        _data.report.yAxis = _outputs.leftStickY - 128;
+    }
 
     // Send outputs to console.
     _n64->write(_data);
@@ -0,0 +1,186 @@
+#ifndef _NATIVE_ADAFRUIT_TINYUSB_H
+#define _NATIVE_ADAFRUIT_TINYUSB_H
+
+/*
+ * The parts of Adafruit TinyUSB that TUCompositeHID uses, for the native test build. The HID
+ * descriptor macros produce the same bytes as TinyUSB's, and the HID endpoint is simulated (see
+ * host.hpp).
+ */
+
+#include "stdlib.hpp"
+
+#define TU_ATTR_PACKED __attribute__((packed))
+#define TU_BIT(n) (1UL << (n))
+
+// clang-format off
+
+#define HID_DATA     (0 << 0)
+#define HID_VARIABLE (1 << 1)
+#define HID_ABSOLUTE (0 << 2)
+
+#define HID_REPORT_DATA_0(data)
+#define HID_REPORT_DATA_1(data) , (uint8_t)(data)
+#define HID_REPORT_DATA_2(data) , (uint8_t)((data) & 0xFF), (uint8_t)(((data) >> 8) & 0xFF)
+#define HID_REPORT_DATA_3(data) , (uint8_t)((data) & 0xFF), (uint8_t)(((data) >> 8) & 0xFF), \
+                                  (uint8_t)(((data) >> 16) & 0xFF), (uint8_t)(((data) >> 24) & 0xFF)
+
+#define HID_REPORT_ITEM(data, tag, type, size) \
+    (((tag) << 4) | ((type) << 2) | (size)) HID_REPORT_DATA_##size(data)
+
+#define HID_INPUT(x)               HID_REPORT_ITEM(x, 8, 0, 1)
+#define HID_COLLECTION(x)          HID_REPORT_ITEM(x, 10, 0, 1)
+#define HID_COLLECTION_END         HID_REPORT_ITEM(x, 12, 0, 0)
+#define HID_USAGE_PAGE(x)          HID_REPORT_ITEM(x, 0, 1, 1)
+#define HID_LOGICAL_MIN(x)         HID_REPORT_ITEM(x, 1, 1, 1)
+#define HID_LOGICAL_MAX(x)         HID_REPORT_ITEM(x, 2, 1, 1)
+#define HID_LOGICAL_MAX_N(x, n)    HID_REPORT_ITEM(x, 2, 1, n)
+#define HID_PHYSICAL_MIN(x)        HID_REPORT_ITEM(x, 3, 1, 1)
+#define HID_PHYSICAL_MAX_N(x, n)   HID_REPORT_ITEM(x, 4, 1, n)
+#define HID_REPORT_SIZE(x)         HID_REPORT_ITEM(x, 7, 1, 1)
+#define HID_REPORT_ID(x)           HID_REPORT_ITEM(x, 8, 1, 1),
+#define HID_REPORT_COUNT(x)        HID_REPORT_ITEM(x, 9, 1, 1)
+#define HID_USAGE(x)               HID_REPORT_ITEM(x, 0, 2, 1)
+#define HID_USAGE_MIN(x)           HID_REPORT_ITEM(x, 1, 2, 1)
+#define HID_USAGE_MAX(x)           HID_REPORT_ITEM(x, 2, 2, 1)
+
+#define HID_COLLECTION_APPLICATION 0x01
+
+#define HID_USAGE_PAGE_DESKTOP     0x01
+#define HID_USAGE_PAGE_KEYBOARD    0x07
+#define HID_USAGE_PAGE_LED         0x08
+#define HID_USAGE_PAGE_BUTTON      0x09
+
+#define HID_USAGE_DESKTOP_GAMEPAD    0x05
+#define HID_USAGE_DESKTOP_KEYBOARD   0x06
+#define HID_USAGE_DESKTOP_X          0x30
+#define HID_USAGE_DESKTOP_Y          0x31
+#define HID_USAGE_DESKTOP_Z          0x32
+#define HID_USAGE_DESKTOP_RX         0x33
+#define HID_USAGE_DESKTOP_RY         0x34
+#define HID_USAGE_DESKTOP_RZ         0x35
+#define HID_USAGE_DESKTOP_HAT_SWITCH 0x39
+
+#define HID_ITF_PROTOCOL_NONE 0
+
+// Boot protocol keyboard: modifier byte, reserved byte and 6 keycode slots.
+#define TUD_HID_REPORT_DESC_KEYBOARD(...) \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     )                 ,\
+    HID_USAGE      ( HID_USAGE_DESKTOP_KEYBOARD )                 ,\
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION )                 ,\
+        __VA_ARGS__ \
+        HID_USAGE_PAGE  ( HID_USAGE_PAGE_KEYBOARD )               ,\
+        HID_USAGE_MIN    ( 224                                    ) ,\
+        HID_USAGE_MAX    ( 231                                    ) ,\
+        HID_LOGICAL_MIN  ( 0                                      ) ,\
+        HID_LOGICAL_MAX  ( 1                                      ) ,\
+        HID_REPORT_COUNT ( 8                                      ) ,\
+        HID_REPORT_SIZE  ( 1                                      ) ,\
+        HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        HID_REPORT_COUNT ( 1                                      ) ,\
+        HID_REPORT_SIZE  ( 8                                      ) ,\
+        HID_INPUT        ( 0x01                                   ) ,\
+        HID_USAGE_PAGE   ( HID_USAGE_PAGE_KEYBOARD                ) ,\
+        HID_USAGE_MIN    ( 0                                      ) ,\
+        HID_USAGE_MAX    ( 255                                    ) ,\
+        HID_LOGICAL_MIN  ( 0                                      ) ,\
+        HID_LOGICAL_MAX  ( 255                                    ) ,\
+        HID_REPORT_COUNT ( 6                                      ) ,\
+        HID_REPORT_SIZE  ( 8                                      ) ,\
+        HID_INPUT        ( HID_DATA                               ) ,\
+    HID_COLLECTION_END
+
+// clang-format on
+
+#define HID_KEY_NONE 0x00
+#define HID_KEY_A 0x04
+#define HID_KEY_B 0x05
+#define HID_KEY_C 0x06
+#define HID_KEY_D 0x07
+#define HID_KEY_E 0x08
+#define HID_KEY_F 0x09
+#define HID_KEY_G 0x0A
+#define HID_KEY_H 0x0B
+#define HID_KEY_I 0x0C
+#define HID_KEY_J 0x0D
+#define HID_KEY_K 0x0E
+#define HID_KEY_L 0x0F
+#define HID_KEY_M 0x10
+#define HID_KEY_N 0x11
+#define HID_KEY_O 0x12
+#define HID_KEY_P 0x13
+#define HID_KEY_Q 0x14
+#define HID_KEY_R 0x15
+#define HID_KEY_S 0x16
+#define HID_KEY_T 0x17
+#define HID_KEY_U 0x18
+#define HID_KEY_V 0x19
+#define HID_KEY_W 0x1A
+#define HID_KEY_X 0x1B
+#define HID_KEY_Y 0x1C
+#define HID_KEY_Z 0x1D
+#define HID_KEY_1 0x1E
+#define HID_KEY_2 0x1F
+#define HID_KEY_3 0x20
+#define HID_KEY_4 0x21
+#define HID_KEY_5 0x22
+#define HID_KEY_6 0x23
+#define HID_KEY_7 0x24
+#define HID_KEY_8 0x25
+#define HID_KEY_9 0x26
+#define HID_KEY_0 0x27
+#define HID_KEY_ENTER 0x28
+#define HID_KEY_ESCAPE 0x29
+#define HID_KEY_BACKSPACE 0x2A
+#define HID_KEY_TAB 0x2B
+#define HID_KEY_SPACE 0x2C
+#define HID_KEY_ARROW_RIGHT 0x4F
+#define HID_KEY_ARROW_LEFT 0x50
+#define HID_KEY_ARROW_DOWN 0x51
+#define HID_KEY_ARROW_UP 0x52
+#define HID_KEY_CONTROL_LEFT 0xE0
+#define HID_KEY_SHIFT_LEFT 0xE1
+#define HID_KEY_ALT_LEFT 0xE2
+#define HID_KEY_GUI_LEFT 0xE3
+#define HID_KEY_CONTROL_RIGHT 0xE4
+#define HID_KEY_SHIFT_RIGHT 0xE5
+#define HID_KEY_ALT_RIGHT 0xE6
+#define HID_KEY_GUI_RIGHT 0xE7
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t modifier;
+    uint8_t reserved;
+    uint8_t keycode[6];
+} hid_keyboard_report_t;
+
+typedef enum {
+    GAMEPAD_HAT_CENTERED = 0,
+    GAMEPAD_HAT_UP = 1,
+    GAMEPAD_HAT_UP_RIGHT = 2,
+    GAMEPAD_HAT_RIGHT = 3,
+    GAMEPAD_HAT_DOWN_RIGHT = 4,
+    GAMEPAD_HAT_DOWN = 5,
+    GAMEPAD_HAT_DOWN_LEFT = 6,
+    GAMEPAD_HAT_LEFT = 7,
+    GAMEPAD_HAT_UP_LEFT = 8,
+} hid_gamepad_hat_t;
+
+class Adafruit_USBD_HID {
+  public:
+    Adafruit_USBD_HID(
+        const uint8_t *desc_report = nullptr,
+        uint16_t len = 0,
+        uint8_t protocol = HID_ITF_PROTOCOL_NONE,
+        uint8_t interval_ms = 4,
+        bool has_out_endpoint = false
+    );
+    void setReportDescriptor(const uint8_t *desc_report, uint16_t len);
+    bool begin();
+    bool ready();
+    bool sendReport(uint8_t report_id, const void *report, uint8_t len);
+
+  private:
+    const uint8_t *_desc_report;
+    uint16_t _desc_report_len;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef _NATIVE_ARDUINO_H
+#define _NATIVE_ARDUINO_H
+
+/*
+ * The parts of the Arduino core that HayBox uses, for the native test build. Time comes from the
+ * simulated clock in host.hpp, so it only moves when something waits or a test advances it.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+#endif
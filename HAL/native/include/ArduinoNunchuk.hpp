@@ -0,0 +1,17 @@
+#ifndef _NATIVE_ARDUINONUNCHUK_HPP
+#define _NATIVE_ARDUINONUNCHUK_HPP
+
+// The arduino-nunchuk library's interface, for the native test build. No Nunchuk ever answers.
+
+#include <Wire.h>
+
+class ArduinoNunchuk {
+  public:
+    ArduinoNunchuk(TwoWire &wire) { (void)wire; }
+    bool init() { return false; }
+    bool update() { return false; }
+    bool buttonC() { return false; }
+    bool buttonZ() { return false; }
+};
+
+#endif
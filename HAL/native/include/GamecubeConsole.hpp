@@ -0,0 +1,30 @@
+#ifndef _NATIVE_GAMECUBECONSOLE_HPP
+#define _NATIVE_GAMECUBECONSOLE_HPP
+
+/*
+ * joybus-pio's GameCube console interface, for the native test build. There is no console on the
+ * other end of the line: Detect() succeeds if the simulated console is a GameCube (see host.hpp),
+ * and polls never arrive.
+ */
+
+#include "gamecube_definitions.h"
+
+#include <hardware/pio.h>
+#include <pico/stdlib.h>
+
+class GamecubeConsole {
+  public:
+    GamecubeConsole(uint pin, PIO pio = pio0, int sm = -1, int offset = -1);
+    ~GamecubeConsole();
+    bool Detect();
+    void WaitForPoll();
+    void WaitForPollStart();
+    PollStatus WaitForPollEnd();
+    void SendReport(gc_report_t *report);
+    int GetOffset();
+
+  private:
+    int _offset;
+};
+
+#endif
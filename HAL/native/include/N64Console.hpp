@@ -0,0 +1,28 @@
+#ifndef _NATIVE_N64CONSOLE_HPP
+#define _NATIVE_N64CONSOLE_HPP
+
+/*
+ * joybus-pio's N64 console interface, for the native test build. There is no console on the other
+ * end of the line: Detect() succeeds if the simulated console is an N64 (see host.hpp), and polls
+ * never arrive.
+ */
+
+#include "n64_definitions.h"
+
+#include <hardware/pio.h>
+#include <pico/stdlib.h>
+
+class N64Console {
+  public:
+    N64Console(uint pin, PIO pio = pio0, int sm = -1, int offset = -1);
+    ~N64Console();
+    bool Detect();
+    void WaitForPoll();
+    void SendReport(n64_report_t *report);
+    int GetOffset();
+
+  private:
+    int _offset;
+};
+
+#endif
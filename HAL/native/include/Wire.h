@@ -0,0 +1,23 @@
+#ifndef _NATIVE_WIRE_H
+#define _NATIVE_WIRE_H
+
+// The Arduino-Pico core's I2C wrapper, for the native test build. Nothing is connected to it.
+
+#include <hardware/i2c.h>
+
+class TwoWire {
+  public:
+    TwoWire(i2c_inst_t *i2c);
+    bool setSDA(int pin);
+    bool setSCL(int pin);
+    void begin();
+    void end();
+
+  private:
+    i2c_inst_t *_i2c;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
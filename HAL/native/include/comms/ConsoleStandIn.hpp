@@ -0,0 +1,132 @@
+#ifndef _COMMS_CONSOLESTANDIN_HPP
+#define _COMMS_CONSOLESTANDIN_HPP
+
+#include "comms/JoybusLink.hpp"
+#include "stdlib.hpp"
+
+typedef struct {
+    uint32_t poll_interval_us; // Average time from the start of one poll to the start of the next
+    uint32_t jitter_us; // Each poll starts up to this much earlier or later than scheduled
+    // How long the console waits for a reply after the end of the poll before giving up. This is a
+    // modelling choice rather than a measured console timeout.
+    uint32_t reply_timeout_us;
+    uint32_t seed; // Seed for the jitter, so that runs are repeatable
+} console_timing_t;
+
+static constexpr console_timing_t default_console_timing = {
+    .poll_interval_us = 16667,
+    .jitter_us = 0,
+    .reply_timeout_us = 60,
+    .seed = 1,
+};
+
+// Commands a GameCube can send. Only polls reach the backend; joybus-pio answers the others itself.
+enum class JoybusCommand {
+    POLL,
+    POLL_RUMBLE, // Poll with the rumble bit set
+    POLL_INVALID, // Poll that wasn't received correctly
+    PROBE,
+    ORIGIN,
+    RECALIBRATE,
+};
+
+typedef struct {
+    uint32_t polls; // Polls the console sent
+    uint32_t replies; // Replies that arrived in time
+    uint32_t missed; // Polls that started while the backend wasn't waiting for one
+    uint32_t late; // Replies sent after the console had given up waiting
+    uint32_t commands; // Other commands, which were answered without involving the backend
+    uint32_t min_reply_us; // Time from the start of the poll to the reply, on the simulated clock
+    uint32_t max_reply_us;
+    uint64_t total_reply_us;
+    uint64_t max_host_ns; // Real time the host spent between receiving a poll and replying
+    uint64_t total_host_ns;
+} console_stats_t;
+
+/**
+ * Issues polls on the simulated clock and measures how the backend replies. Waiting for a poll
+ * moves the clock forward to its start, and the reply time is taken from the clock when the reply
+ * is sent, so it includes any waits the backend does in between. The real time the host spent on
+ * the same stretch of code is measured alongside, for benchmarking.
+ *
+ * Optionally, the simulated reply time of every poll is written to a log.
+ */
+class ConsoleStandIn {
+  public:
+    // The backend learns of a poll notify_us after it starts, and the whole command has been
+    // received after command_us.
+    ConsoleStandIn(const console_timing_t &timing, uint32_t notify_us, uint32_t command_us);
+    void GetStats(console_stats_t &stats);
+    void SetReplyLog(uint32_t *log, size_t capacity);
+    size_t ReplyLogLength();
+
+  protected:
+    // Moves the clock to the point where the backend learns of the next poll it can still answer.
+    void NextPoll();
+    // Lets the next command slot go by without the backend, taking command_us to receive and
+    // reply_us to answer.
+    void SkipCommand(uint32_t command_us, uint32_t reply_us);
+    // Moves the clock to the point where the whole poll command has been received.
+    void FinishPoll();
+    void Replied();
+
+  private:
+    console_timing_t _timing;
+    uint32_t _notify_us;
+    uint32_t _command_us;
+    uint32_t _random;
+    uint64_t _next_poll_us;
+    uint64_t _poll_start_us = 0;
+    uint64_t _host_start_ns = 0;
+    console_stats_t _stats;
+    uint32_t *_log = nullptr;
+    size_t _log_capacity = 0;
+    size_t _log_length = 0;
+
+    uint64_t SchedulePoll(uint64_t previous_us);
+    uint64_t TakeSlot();
+};
+
+/**
+ * A GameCube on the simulated clock. The backend learns of a poll once its first byte is in, and
+ * the reply is due when the whole 25-bit command has been received.
+ *
+ * By default every command is a poll, with the rumble bit as set by SetRumble(). SetCommands()
+ * plays a script of commands first, one per poll interval. Like joybus-pio, WaitForPollStart()
+ * answers probe, origin and recalibrate commands itself and keeps waiting for a poll.
+ */
+class GamecubeConsoleStandIn : public GamecubeLink, public ConsoleStandIn {
+  public:
+    GamecubeConsoleStandIn(const console_timing_t &timing = default_console_timing);
+    void WaitForPollStart();
+    PollStatus WaitForPollEnd();
+    void SendReport(gc_report_t *report);
+    int GetOffset();
+
+    void SetRumble(bool rumble);
+    void SetCommands(const JoybusCommand *commands, size_t count);
+    const gc_report_t &LastReport();
+
+  private:
+    bool _rumble = false;
+    const JoybusCommand *_commands = nullptr;
+    size_t _command_count = 0;
+    JoybusCommand _command = JoybusCommand::POLL;
+    gc_report_t _last_report = default_gc_report;
+};
+
+// An N64 on the simulated clock. The backend learns of a poll once its whole 9-bit command is in.
+class N64ConsoleStandIn : public N64Link, public ConsoleStandIn {
+  public:
+    N64ConsoleStandIn(const console_timing_t &timing = default_console_timing);
+    void WaitForPoll();
+    void SendReport(n64_report_t *report);
+    int GetOffset();
+
+    const n64_report_t &LastReport();
+
+  private:
+    n64_report_t _last_report = default_n64_report;
+};
+
+#endif
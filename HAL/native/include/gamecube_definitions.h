@@ -0,0 +1,66 @@
+#ifndef _NATIVE_GAMECUBE_DEFINITIONS_H
+#define _NATIVE_GAMECUBE_DEFINITIONS_H
+
+// joybus-pio's GameCube report and poll status types, for the native test build.
+
+#include <stdint.h>
+
+typedef struct __attribute__((packed)) {
+    uint8_t a : 1;
+    uint8_t b : 1;
+    uint8_t x : 1;
+    uint8_t y : 1;
+    uint8_t start : 1;
+    uint8_t origin : 1;
+    uint8_t err_latch : 1;
+    uint8_t err_status : 1;
+
+    uint8_t dpad_left : 1;
+    uint8_t dpad_right : 1;
+    uint8_t dpad_down : 1;
+    uint8_t dpad_up : 1;
+    uint8_t z : 1;
+    uint8_t r : 1;
+    uint8_t l : 1;
+    uint8_t high1 : 1;
+
+    uint8_t stick_x;
+    uint8_t stick_y;
+    uint8_t cstick_x;
+    uint8_t cstick_y;
+    uint8_t l_analog;
+    uint8_t r_analog;
+} gc_report_t;
+
+static constexpr gc_report_t default_gc_report = {
+    .a = 0,
+    .b = 0,
+    .x = 0,
+    .y = 0,
+    .start = 0,
+    .origin = 0,
+    .err_latch = 0,
+    .err_status = 0,
+    .dpad_left = 0,
+    .dpad_right = 0,
+    .dpad_down = 0,
+    .dpad_up = 0,
+    .z = 0,
+    .r = 0,
+    .l = 0,
+    .high1 = 1,
+    .stick_x = 128,
+    .stick_y = 128,
+    .cstick_x = 128,
+    .cstick_y = 128,
+    .l_analog = 0,
+    .r_analog = 0,
+};
+
+enum class PollStatus {
+    RUMBLE_OFF,
+    RUMBLE_ON,
+    ERROR,
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef _NATIVE_HARDWARE_DMA_H
+#define _NATIVE_HARDWARE_DMA_H
+
+/*
+ * The parts of the Pico SDK's DMA API that HayBox uses, for the native test build. A transfer is
+ * carried out in full as soon as it is triggered, except one paced by an SPI block's receive DREQ,
+ * which moves one byte for each byte the block sends. Once a transfer has finished, its completion
+ * interrupt is raised and any chained channel started.
+ */
+
+#include <pico/stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_DMA_CHANNELS 12
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2,
+};
+
+typedef struct {
+    enum dma_channel_transfer_size size;
+    bool read_increment;
+    bool write_increment;
+    uint dreq;
+    uint chain_to;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(
+    dma_channel_config *config,
+    enum dma_channel_transfer_size size
+);
+void channel_config_set_read_increment(dma_channel_config *config, bool increment);
+void channel_config_set_write_increment(dma_channel_config *config, bool increment);
+void channel_config_set_dreq(dma_channel_config *config, uint dreq);
+void channel_config_set_chain_to(dma_channel_config *config, uint channel);
+
+void dma_channel_configure(
+    uint channel,
+    const dma_channel_config *config,
+    volatile void *write_addr,
+    const volatile void *read_addr,
+    uint transfer_count,
+    bool trigger
+);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint transfer_count, bool trigger);
+void dma_channel_transfer_from_buffer_now(
+    uint channel,
+    const volatile void *read_addr,
+    uint transfer_count
+);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+
+void dma_channel_set_irq1_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq1_status(uint channel);
+void dma_channel_acknowledge_irq1(uint channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef _NATIVE_HARDWARE_GPIO_H
+#define _NATIVE_HARDWARE_GPIO_H
+
+/*
+ * The parts of the Pico SDK's GPIO API that HayBox uses, for the native test build. Pin levels are
+ * simulated (see host.hpp).
+ */
+
+#include <pico/stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_BANK0_GPIOS 30
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+enum gpio_function {
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_NULL = 0x1F,
+};
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+bool gpio_get(uint gpio);
+void gpio_put(uint gpio, bool value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
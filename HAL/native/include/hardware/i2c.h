@@ -0,0 +1,54 @@
+#ifndef _NATIVE_HARDWARE_I2C_H
+#define _NATIVE_HARDWARE_I2C_H
+
+/*
+ * The parts of the Pico SDK's I2C API that HayBox and OneBitDisplay use, for the native test build.
+ * Bytes written with i2c_write_blocking(), or by DMA to the data/command register, are passed on to
+ * the simulated devices on the bus (see host.hpp). The other registers are plain memory that tests
+ * can set to simulate the controller's state.
+ */
+
+#include <pico/stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define I2C_IC_DATA_CMD_CMD_BITS 0x00000100
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200
+#define I2C_IC_STATUS_ACTIVITY_BITS 0x00000001
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x00000040
+
+typedef struct {
+    volatile uint32_t enable;
+    volatile uint32_t tar;
+    volatile uint32_t data_cmd;
+    volatile uint32_t status;
+    volatile uint32_t txflr;
+    volatile uint32_t rxflr;
+    volatile uint32_t raw_intr_stat;
+    volatile uint32_t clr_tx_abrt;
+} i2c_hw_t;
+
+typedef struct i2c_inst {
+    i2c_hw_t *hw;
+    bool restart_on_next;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+uint i2c_hw_index(i2c_inst_t *i2c);
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _NATIVE_HARDWARE_IRQ_H
+#define _NATIVE_HARDWARE_IRQ_H
+
+/*
+ * The parts of the Pico SDK's interrupt API that HayBox uses, for the native test build. Handlers
+ * are called straight away when the simulated hardware raises their interrupt.
+ */
+
+#include <pico/stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_remove_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef _NATIVE_HARDWARE_PIO_H
+#define _NATIVE_HARDWARE_PIO_H
+
+/*
+ * PIO instance handles, for the native test build. Nothing runs on them; they only identify which
+ * block a Joybus instance was meant to use.
+ */
+
+#include <pico/stdlib.h>
+
+typedef struct pio_hw {
+    uint index;
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t pio_blocks[2];
+
+#define pio0 (&pio_blocks[0])
+#define pio1 (&pio_blocks[1])
+
+#endif
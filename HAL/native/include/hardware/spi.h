@@ -0,0 +1,66 @@
+#ifndef _NATIVE_HARDWARE_SPI_H
+#define _NATIVE_HARDWARE_SPI_H
+
+/*
+ * The parts of the Pico SDK's SPI API that HayBox and OneBitDisplay use, for the native test build.
+ * Bytes written with spi_write_blocking(), or by DMA to the data register, are passed on to the
+ * simulated device on the bus (see host.hpp), and the transmit FIFO is always empty.
+ */
+
+#include <pico/stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SPI_CPHA_0 = 0,
+    SPI_CPHA_1 = 1,
+} spi_cpha_t;
+
+typedef enum {
+    SPI_CPOL_0 = 0,
+    SPI_CPOL_1 = 1,
+} spi_cpol_t;
+
+typedef enum {
+    SPI_LSB_FIRST = 0,
+    SPI_MSB_FIRST = 1,
+} spi_order_t;
+
+typedef struct {
+    volatile uint32_t cr0;
+    volatile uint32_t cr1;
+    volatile uint32_t dr;
+    volatile uint32_t sr;
+} spi_hw_t;
+
+typedef struct spi_inst {
+    spi_hw_t *hw;
+} spi_inst_t;
+
+extern spi_inst_t spi0_inst;
+extern spi_inst_t spi1_inst;
+
+#define spi0 (&spi0_inst)
+#define spi1 (&spi1_inst)
+
+uint spi_init(spi_inst_t *spi, uint baudrate);
+void spi_set_format(
+    spi_inst_t *spi,
+    uint data_bits,
+    spi_cpol_t cpol,
+    spi_cpha_t cpha,
+    spi_order_t order
+);
+spi_hw_t *spi_get_hw(spi_inst_t *spi);
+uint spi_get_index(spi_inst_t *spi);
+uint spi_get_dreq(spi_inst_t *spi, bool is_tx);
+bool spi_is_busy(spi_inst_t *spi);
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef _NATIVE_HARDWARE_TIMER_H
+#define _NATIVE_HARDWARE_TIMER_H
+
+// The timer functions are declared with the rest of the simulated clock.
+#include <pico/stdlib.h>
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef _NATIVE_HOST_HPP
+#define _NATIVE_HOST_HPP
+
+#include "joybus_utils.hpp"
+#include "stdlib.hpp"
+
+#include <hardware/i2c.h>
+#include <hardware/spi.h>
+
+// Size of the simulated OLED panel's memory. The SH1106 has 132 columns, the SSD1306 uses 128.
+#define OLED_PANEL_COLUMNS 132
+#define OLED_PANEL_PAGES 8
+
+/**
+ * Controls for the simulated hardware behind the native HAL. Tests use these to drive time and
+ * peripherals and to inspect what the code under test did with them.
+ */
+namespace host {
+    // Puts every simulated peripheral back into its power-on state.
+    void reset();
+
+    // Simulated clock, in microseconds. It only moves when code waits or a test moves it.
+    void set_micros(uint64_t us);
+    void advance_micros(uint64_t us);
+
+    // GPIO. Setting a pin's level overrides its pull resistor, as if something was driving it.
+    void set_pin(uint pin, bool level);
+    enum gpio_function pin_function(uint pin);
+
+    // USB HID endpoint. While busy, ready() returns false for the given number of checks, or
+    // forever if the count is negative.
+    void set_usb_busy(int checks);
+    size_t usb_reports_sent();
+    size_t usb_last_report(uint8_t *report, size_t max_len);
+
+    // USB serial. Bytes written by the code under test are captured, and bytes queued here are
+    // returned by serial::read().
+    void set_serial_connected(bool connected);
+    void set_serial_write_space(int bytes);
+    void queue_serial_input(const uint8_t *bytes, size_t len);
+    size_t serial_output(uint8_t *bytes, size_t max_len);
+    void clear_serial_output();
+
+    // Emulated EEPROM. Counts how many times a write actually had to commit to flash.
+    size_t storage_commits();
+
+    // Joybus. Console detection only succeeds for the simulated console, and every Detect() call
+    // is logged so tests can check the order consoles were probed in.
+    void set_joybus_console(ConnectedConsole console);
+    size_t joybus_probes(ConnectedConsole *order, size_t max_len);
+
+    // DMA. Transfers normally run to completion as soon as they are triggered, and ones paced by an
+    // SPI block's receive FIFO as soon as that block has sent enough bytes. While held, triggered
+    // transfers are left pending, and the channel reads as busy, until they are released.
+    void hold_dma(bool hold);
+
+    // SPI. Counts the bytes sent with spi_write_blocking(), rather than by DMA.
+    size_t spi_blocking_bytes();
+
+    // Simulated SSD1306/SH1106 OLED panel, attached to an I2C address or to an SPI block with its
+    // CS and D/C pins. Only the page and column addressing commands are interpreted, so its memory
+    // holds exactly what was written where. Nothing answers on the I2C bus other than the panel,
+    // and a transfer to any other address aborts, which the test has to clear itself.
+    void attach_oled_i2c(i2c_inst_t *i2c, uint8_t address);
+    void attach_oled_spi(spi_inst_t *spi, uint cs_pin, uint dc_pin);
+    // Copies the panel's memory, page by page.
+    size_t oled_memory(uint8_t *memory, size_t max_len);
+    size_t oled_data_bytes();
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef _NATIVE_N64_DEFINITIONS_H
+#define _NATIVE_N64_DEFINITIONS_H
+
+// joybus-pio's N64 report type, for the native test build.
+
+#include <stdint.h>
+
+typedef struct __attribute__((packed)) {
+    uint8_t dpad_right : 1;
+    uint8_t dpad_left : 1;
+    uint8_t dpad_down : 1;
+    uint8_t dpad_up : 1;
+    uint8_t start : 1;
+    uint8_t z : 1;
+    uint8_t b : 1;
+    uint8_t a : 1;
+
+    uint8_t c_right : 1;
+    uint8_t c_left : 1;
+    uint8_t c_down : 1;
+    uint8_t c_up : 1;
+    uint8_t r : 1;
+    uint8_t l : 1;
+    uint8_t reserved0 : 1;
+    uint8_t reset : 1;
+
+    int8_t stick_x;
+    int8_t stick_y;
+} n64_report_t;
+
+static constexpr n64_report_t default_n64_report = {
+    .dpad_right = 0,
+    .dpad_left = 0,
+    .dpad_down = 0,
+    .dpad_up = 0,
+    .start = 0,
+    .z = 0,
+    .b = 0,
+    .a = 0,
+    .c_right = 0,
+    .c_left = 0,
+    .c_down = 0,
+    .c_up = 0,
+    .r = 0,
+    .l = 0,
+    .reserved0 = 0,
+    .reset = 0,
+    .stick_x = 0,
+    .stick_y = 0,
+};
+
+#endif
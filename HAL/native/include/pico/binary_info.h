@@ -0,0 +1,6 @@
+#ifndef _NATIVE_PICO_BINARY_INFO_H
+#define _NATIVE_PICO_BINARY_INFO_H
+
+// Binary info only matters to picotool, so there is nothing to declare for the native test build.
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef _NATIVE_PICO_STDLIB_H
+#define _NATIVE_PICO_STDLIB_H
+
+/*
+ * The parts of the Pico SDK's pico/stdlib.h that HayBox uses, for the native test build. Waits
+ * advance the simulated clock instead of spinning.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+#include <hardware/gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t absolute_time_t;
+
+uint32_t time_us_32();
+uint64_t time_us_64();
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+void busy_wait_us(uint64_t us);
+void busy_wait_us_32(uint32_t us);
+absolute_time_t get_absolute_time();
+uint32_t to_ms_since_boot(absolute_time_t t);
+
+// Every pass of a spin loop takes a little time on hardware, so it does here too. Otherwise a loop
+// waiting on the clock would never finish.
+void tight_loop_contents();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef _NATIVE_TRACE_DIFF_HPP
+#define _NATIVE_TRACE_DIFF_HPP
+
+#include "core/ControllerMode.hpp"
+#include "core/TraceRecorder.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+typedef struct {
+    size_t index; // Index of the record in the trace
+    uint16_t sequence; // Sequence number of the recorded poll
+    OutputState expected; // Outputs recorded for the poll
+    OutputState actual; // Outputs the mode produced when the poll was replayed
+} trace_mismatch_t;
+
+/**
+ * Replays a recorded trace through a mode, one poll per record, and compares the outputs of every
+ * poll with the recorded ones. Returns how many polls differ. The first max_mismatches of them are
+ * stored in mismatches, which may be nullptr if only the count is needed.
+ *
+ * The mode keeps its state between polls, as it would on the controller, so the trace should start
+ * from the mode's initial state, i.e. from when the mode was selected.
+ */
+size_t trace_diff(
+    ControllerMode &mode,
+    const trace_record_t *records,
+    size_t record_count,
+    trace_mismatch_t *mismatches = nullptr,
+    size_t max_mismatches = 0
+);
+
+// Compares every field of two output states.
+bool outputs_equal(const OutputState &a, const OutputState &b);
+
+#endif
@@ -0,0 +1,75 @@
+#include <Adafruit_TinyUSB.h>
+
+#include "host.hpp"
+
+#define USB_REPORT_SIZE 64
+
+static int busy_checks = 0;
+static size_t reports_sent = 0;
+static uint8_t last_report[USB_REPORT_SIZE];
+static size_t last_report_len = 0;
+
+namespace host {
+    void set_usb_busy(int checks) {
+        busy_checks = checks;
+    }
+
+    size_t usb_reports_sent() {
+        return reports_sent;
+    }
+
+    size_t usb_last_report(uint8_t *report, size_t max_len) {
+        size_t len = last_report_len < max_len ? last_report_len : max_len;
+        memcpy(report, last_report, len);
+        return len;
+    }
+
+    void reset_usb() {
+        busy_checks = 0;
+        reports_sent = 0;
+        last_report_len = 0;
+    }
+}
+
+Adafruit_USBD_HID::Adafruit_USBD_HID(
+    const uint8_t *desc_report,
+    uint16_t len,
+    uint8_t protocol,
+    uint8_t interval_ms,
+    bool has_out_endpoint
+) {
+    (void)protocol;
+    (void)interval_ms;
+    (void)has_out_endpoint;
+    setReportDescriptor(desc_report, len);
+}
+
+void Adafruit_USBD_HID::setReportDescriptor(const uint8_t *desc_report, uint16_t len) {
+    _desc_report = desc_report;
+    _desc_report_len = len;
+}
+
+bool Adafruit_USBD_HID::begin() {
+    return true;
+}
+
+bool Adafruit_USBD_HID::ready() {
+    if (busy_checks == 0) {
+        return true;
+    }
+    if (busy_checks > 0) {
+        busy_checks--;
+    }
+    return false;
+}
+
+bool Adafruit_USBD_HID::sendReport(uint8_t report_id, const void *report, uint8_t len) {
+    if (!ready()) {
+        return false;
+    }
+    last_report[0] = report_id;
+    last_report_len = 1 + (len < USB_REPORT_SIZE - 1 ? len : USB_REPORT_SIZE - 1);
+    memcpy(&last_report[1], report, last_report_len - 1);
+    reports_sent++;
+    return true;
+}
@@ -0,0 +1,211 @@
+#include "comms/ConsoleStandIn.hpp"
+
+#include "host.hpp"
+
+#include <chrono>
+
+// Joybus sends a bit every 4us. A GameCube poll is three bytes and a stop bit, and the backend is
+// told about it once the first byte is in. An N64 poll is one byte and a stop bit.
+#define GAMECUBE_NOTIFY_US (8 * 4)
+#define GAMECUBE_COMMAND_US (25 * 4)
+#define N64_COMMAND_US (9 * 4)
+
+// Probe and origin are one byte and a stop bit, recalibrate is three bytes. The probe reply is three
+// bytes and the origin reply ten, each with a stop bit.
+#define SHORT_COMMAND_US (9 * 4)
+#define PROBE_REPLY_US (25 * 4)
+#define ORIGIN_REPLY_US (81 * 4)
+
+static uint64_t host_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+    )
+        .count();
+}
+
+ConsoleStandIn::ConsoleStandIn(
+    const console_timing_t &timing,
+    uint32_t notify_us,
+    uint32_t command_us
+) {
+    _timing = timing;
+    _notify_us = notify_us;
+    _command_us = command_us;
+    _random = timing.seed != 0 ? timing.seed : 1;
+    _next_poll_us = SchedulePoll(time_us_64());
+    _stats = {};
+    _stats.min_reply_us = 0xFFFFFFFF;
+}
+
+void ConsoleStandIn::GetStats(console_stats_t &stats) {
+    stats = _stats;
+}
+
+void ConsoleStandIn::SetReplyLog(uint32_t *log, size_t capacity) {
+    _log = log;
+    _log_capacity = capacity;
+    _log_length = 0;
+}
+
+size_t ConsoleStandIn::ReplyLogLength() {
+    return _log_length;
+}
+
+uint64_t ConsoleStandIn::SchedulePoll(uint64_t previous_us) {
+    uint64_t next_us = previous_us + _timing.poll_interval_us;
+    if (_timing.jitter_us == 0) {
+        return next_us;
+    }
+
+    // xorshift32
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    uint32_t offset = _random % (2 * _timing.jitter_us + 1);
+    return next_us + offset - _timing.jitter_us;
+}
+
+uint64_t ConsoleStandIn::TakeSlot() {
+    // A poll can no longer be answered once the console has stopped waiting for the reply.
+    uint64_t now = time_us_64();
+    while (_next_poll_us + _command_us + _timing.reply_timeout_us < now) {
+        _stats.polls++;
+        _stats.missed++;
+        _next_poll_us = SchedulePoll(_next_poll_us);
+    }
+
+    uint64_t start_us = _next_poll_us;
+    _next_poll_us = SchedulePoll(_next_poll_us);
+    return start_us;
+}
+
+void ConsoleStandIn::NextPoll() {
+    _stats.polls++;
+    _poll_start_us = TakeSlot();
+    if (time_us_64() < _poll_start_us + _notify_us) {
+        host::set_micros(_poll_start_us + _notify_us);
+    }
+    _host_start_ns = host_ns();
+}
+
+void ConsoleStandIn::SkipCommand(uint32_t command_us, uint32_t reply_us) {
+    _stats.commands++;
+    uint64_t end_us = TakeSlot() + command_us + reply_us;
+    if (time_us_64() < end_us) {
+        host::set_micros(end_us);
+    }
+}
+
+void ConsoleStandIn::FinishPoll() {
+    if (time_us_64() < _poll_start_us + _command_us) {
+        host::set_micros(_poll_start_us + _command_us);
+    }
+}
+
+void ConsoleStandIn::Replied() {
+    uint64_t host_elapsed_ns = host_ns() - _host_start_ns;
+    uint64_t now = time_us_64();
+    uint32_t reply_us = now - _poll_start_us;
+
+    if (now > _poll_start_us + _command_us + _timing.reply_timeout_us) {
+        _stats.late++;
+    } else {
+        _stats.replies++;
+    }
+    if (reply_us < _stats.min_reply_us) {
+        _stats.min_reply_us = reply_us;
+    }
+    if (reply_us > _stats.max_reply_us) {
+        _stats.max_reply_us = reply_us;
+    }
+    _stats.total_reply_us += reply_us;
+    if (host_elapsed_ns > _stats.max_host_ns) {
+        _stats.max_host_ns = host_elapsed_ns;
+    }
+    _stats.total_host_ns += host_elapsed_ns;
+
+    if (_log_length < _log_capacity) {
+        _log[_log_length++] = reply_us;
+    }
+}
+
+GamecubeConsoleStandIn::GamecubeConsoleStandIn(const console_timing_t &timing)
+    : ConsoleStandIn(timing, GAMECUBE_NOTIFY_US, GAMECUBE_COMMAND_US) {}
+
+void GamecubeConsoleStandIn::WaitForPollStart() {
+    while (true) {
+        _command = JoybusCommand::POLL;
+        if (_command_count > 0) {
+            _command = *_commands++;
+            _command_count--;
+        } else if (_rumble) {
+            _command = JoybusCommand::POLL_RUMBLE;
+        }
+
+        switch (_command) {
+            case JoybusCommand::PROBE:
+                SkipCommand(SHORT_COMMAND_US, PROBE_REPLY_US);
+                break;
+            case JoybusCommand::ORIGIN:
+                SkipCommand(SHORT_COMMAND_US, ORIGIN_REPLY_US);
+                break;
+            case JoybusCommand::RECALIBRATE:
+                SkipCommand(GAMECUBE_COMMAND_US, ORIGIN_REPLY_US);
+                break;
+            default:
+                NextPoll();
+                return;
+        }
+    }
+}
+
+PollStatus GamecubeConsoleStandIn::WaitForPollEnd() {
+    FinishPoll();
+    if (_command == JoybusCommand::POLL_INVALID) {
+        return PollStatus::ERROR;
+    }
+    return _command == JoybusCommand::POLL_RUMBLE ? PollStatus::RUMBLE_ON : PollStatus::RUMBLE_OFF;
+}
+
+void GamecubeConsoleStandIn::SendReport(gc_report_t *report) {
+    _last_report = *report;
+    Replied();
+}
+
+int GamecubeConsoleStandIn::GetOffset() {
+    return -1;
+}
+
+void GamecubeConsoleStandIn::SetRumble(bool rumble) {
+    _rumble = rumble;
+}
+
+void GamecubeConsoleStandIn::SetCommands(const JoybusCommand *commands, size_t count) {
+    _commands = commands;
+    _command_count = count;
+}
+
+const gc_report_t &GamecubeConsoleStandIn::LastReport() {
+    return _last_report;
+}
+
+N64ConsoleStandIn::N64ConsoleStandIn(const console_timing_t &timing)
+    : ConsoleStandIn(timing, N64_COMMAND_US, N64_COMMAND_US) {}
+
+void N64ConsoleStandIn::WaitForPoll() {
+    NextPoll();
+    FinishPoll();
+}
+
+void N64ConsoleStandIn::SendReport(n64_report_t *report) {
+    _last_report = *report;
+    Replied();
+}
+
+int N64ConsoleStandIn::GetOffset() {
+    return -1;
+}
+
+const n64_report_t &N64ConsoleStandIn::LastReport() {
+    return _last_report;
+}
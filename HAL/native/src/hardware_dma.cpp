@@ -0,0 +1,295 @@
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+
+#include <string.h>
+
+#define DREQ_SPI0_RX 17
+
+typedef struct {
+    bool claimed;
+    dma_channel_config config;
+    volatile void *write_addr;
+    const volatile void *read_addr;
+    uint transfer_count;
+    bool pending; // Triggered while transfers are held
+    bool paced; // Waiting for bytes received by an SPI block
+    bool completed; // Finished, but its interrupt and chained channel haven't been handled yet
+    bool irq1_enabled;
+    bool irq1_status;
+} dma_channel_t;
+
+static dma_channel_t channels[NUM_DMA_CHANNELS];
+static bool held = false;
+// Set while completions are being handled, so that channels finishing meanwhile are handled by the
+// same loop rather than from inside an interrupt handler.
+static bool completing = false;
+
+namespace host {
+    bool i2c_register_write(volatile void *addr, uint32_t value);
+    bool spi_register_write(volatile void *addr, uint32_t value);
+    void raise_irq(uint num);
+
+    void reset_dma() {
+        memset(channels, 0, sizeof(channels));
+        held = false;
+        completing = false;
+    }
+
+    // DREQ number of SPI0's receive FIFO. SPI1's follows SPI0's transmit DREQ.
+    static bool spi_rx_dreq(uint dreq, uint *block) {
+        if (dreq == DREQ_SPI0_RX || dreq == DREQ_SPI0_RX + 2) {
+            *block = (dreq - DREQ_SPI0_RX) / 2;
+            return true;
+        }
+        return false;
+    }
+
+    // Raises the interrupts and starts the chained channels of every channel that has finished.
+    static void complete_channels() {
+        if (completing) {
+            return;
+        }
+        completing = true;
+        bool any = true;
+        while (any) {
+            any = false;
+            for (uint channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+                dma_channel_t &ch = channels[channel];
+                if (!ch.completed) {
+                    continue;
+                }
+                ch.completed = false;
+                any = true;
+                if (ch.irq1_enabled) {
+                    ch.irq1_status = true;
+                    raise_irq(DMA_IRQ_1);
+                }
+                if (ch.config.chain_to != channel) {
+                    dma_channel_start(ch.config.chain_to);
+                }
+            }
+        }
+        completing = false;
+    }
+
+    static void write_element(
+        volatile void *addr,
+        uint32_t value,
+        enum dma_channel_transfer_size size
+    ) {
+        if (i2c_register_write(addr, value) || spi_register_write(addr, value)) {
+            return;
+        }
+        switch (size) {
+            case DMA_SIZE_8:
+                *(volatile uint8_t *)addr = value;
+                break;
+            case DMA_SIZE_16:
+                *(volatile uint16_t *)addr = value;
+                break;
+            case DMA_SIZE_32:
+                *(volatile uint32_t *)addr = value;
+                break;
+        }
+    }
+
+    static void run_channel(uint channel) {
+        dma_channel_t &ch = channels[channel];
+        ch.pending = false;
+
+        // A channel paced by an SPI block's receive FIFO moves one element for each byte the
+        // block sends.
+        uint block;
+        if (spi_rx_dreq(ch.config.dreq, &block) && ch.transfer_count > 0) {
+            ch.paced = true;
+            return;
+        }
+
+        size_t size = 1 << ch.config.size;
+        const volatile uint8_t *read = (const volatile uint8_t *)ch.read_addr;
+        volatile uint8_t *write = (volatile uint8_t *)ch.write_addr;
+        for (uint i = 0; i < ch.transfer_count; i++) {
+            uint32_t value = 0;
+            switch (ch.config.size) {
+                case DMA_SIZE_8:
+                    value = *read;
+                    break;
+                case DMA_SIZE_16:
+                    value = *(const volatile uint16_t *)read;
+                    break;
+                case DMA_SIZE_32:
+                    value = *(const volatile uint32_t *)read;
+                    break;
+            }
+            write_element(write, value, ch.config.size);
+            read += ch.config.read_increment ? size : 0;
+            write += ch.config.write_increment ? size : 0;
+        }
+        ch.read_addr = read;
+        ch.write_addr = write;
+        ch.transfer_count = 0;
+        ch.completed = true;
+    }
+
+    // Called for every byte an SPI block sends, which it receives at the same time.
+    void dma_spi_received(uint block) {
+        for (uint channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+            dma_channel_t &ch = channels[channel];
+            uint rx_block;
+            if (!ch.paced || !spi_rx_dreq(ch.config.dreq, &rx_block) || rx_block != block) {
+                continue;
+            }
+            // Nothing is connected to MISO, so only zeroes are received.
+            write_element(ch.write_addr, 0, ch.config.size);
+            if (ch.config.write_increment) {
+                ch.write_addr = (volatile uint8_t *)ch.write_addr + (1 << ch.config.size);
+            }
+            if (--ch.transfer_count == 0) {
+                ch.paced = false;
+                ch.completed = true;
+            }
+        }
+        complete_channels();
+    }
+
+    void hold_dma(bool hold) {
+        held = hold;
+        if (hold) {
+            return;
+        }
+        // Channels waiting for an SPI block to receive are armed first, so they see every byte
+        // the other channels send.
+        for (int paced = 1; paced >= 0; paced--) {
+            for (uint channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+                uint block;
+                if (channels[channel].pending &&
+                    spi_rx_dreq(channels[channel].config.dreq, &block) == (bool)paced) {
+                    run_channel(channel);
+                }
+            }
+        }
+        complete_channels();
+    }
+}
+
+int dma_claim_unused_channel(bool required) {
+    (void)required;
+    for (uint channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+        if (!channels[channel].claimed) {
+            channels[channel].claimed = true;
+            return channel;
+        }
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    channels[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config config;
+    config.size = DMA_SIZE_32;
+    config.read_increment = true;
+    config.write_increment = false;
+    config.dreq = 0x3F;
+    config.chain_to = channel;
+    return config;
+}
+
+void channel_config_set_transfer_data_size(
+    dma_channel_config *config,
+    enum dma_channel_transfer_size size
+) {
+    config->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *config, bool increment) {
+    config->read_increment = increment;
+}
+
+void channel_config_set_write_increment(dma_channel_config *config, bool increment) {
+    config->write_increment = increment;
+}
+
+void channel_config_set_dreq(dma_channel_config *config, uint dreq) {
+    config->dreq = dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *config, uint channel) {
+    config->chain_to = channel;
+}
+
+void dma_channel_configure(
+    uint channel,
+    const dma_channel_config *config,
+    volatile void *write_addr,
+    const volatile void *read_addr,
+    uint transfer_count,
+    bool trigger
+) {
+    dma_channel_t &ch = channels[channel];
+    ch.config = *config;
+    ch.write_addr = write_addr;
+    ch.read_addr = read_addr;
+    ch.transfer_count = transfer_count;
+    if (trigger) {
+        dma_channel_start(channel);
+    }
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {
+    channels[channel].read_addr = read_addr;
+    if (trigger) {
+        dma_channel_start(channel);
+    }
+}
+
+void dma_channel_set_trans_count(uint channel, uint transfer_count, bool trigger) {
+    channels[channel].transfer_count = transfer_count;
+    if (trigger) {
+        dma_channel_start(channel);
+    }
+}
+
+void dma_channel_transfer_from_buffer_now(
+    uint channel,
+    const volatile void *read_addr,
+    uint transfer_count
+) {
+    channels[channel].read_addr = read_addr;
+    channels[channel].transfer_count = transfer_count;
+    dma_channel_start(channel);
+}
+
+void dma_channel_start(uint channel) {
+    if (held) {
+        channels[channel].pending = true;
+        return;
+    }
+    host::run_channel(channel);
+    host::complete_channels();
+}
+
+void dma_channel_abort(uint channel) {
+    channels[channel].pending = false;
+    channels[channel].paced = false;
+    channels[channel].completed = false;
+    channels[channel].transfer_count = 0;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return channels[channel].pending || channels[channel].paced;
+}
+
+void dma_channel_set_irq1_enabled(uint channel, bool enabled) {
+    channels[channel].irq1_enabled = enabled;
+}
+
+bool dma_channel_get_irq1_status(uint channel) {
+    return channels[channel].irq1_status;
+}
+
+void dma_channel_acknowledge_irq1(uint channel) {
+    channels[channel].irq1_status = false;
+}
@@ -0,0 +1,61 @@
+#include <hardware/gpio.h>
+
+#include "host.hpp"
+
+typedef struct {
+    bool level;
+    bool driven; // Level set by a test, which overrides the pull resistors
+    enum gpio_function function;
+} pin_state_t;
+
+static pin_state_t pins[NUM_BANK0_GPIOS];
+
+namespace host {
+    void set_pin(uint pin, bool level) {
+        pins[pin].level = level;
+        pins[pin].driven = true;
+    }
+
+    enum gpio_function pin_function(uint pin) {
+        return pins[pin].function;
+    }
+
+    void reset_gpio() {
+        for (pin_state_t &pin : pins) {
+            pin = { false, false, GPIO_FUNC_NULL };
+        }
+    }
+}
+
+void gpio_init(uint gpio) {
+    pins[gpio].function = GPIO_FUNC_SIO;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    (void)gpio;
+    (void)out;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    pins[gpio].function = fn;
+}
+
+void gpio_pull_up(uint gpio) {
+    if (!pins[gpio].driven) {
+        pins[gpio].level = true;
+    }
+}
+
+void gpio_pull_down(uint gpio) {
+    if (!pins[gpio].driven) {
+        pins[gpio].level = false;
+    }
+}
+
+bool gpio_get(uint gpio) {
+    return pins[gpio].level;
+}
+
+void gpio_put(uint gpio, bool value) {
+    pins[gpio].level = value;
+}
@@ -0,0 +1,130 @@
+#include <Wire.h>
+#include <hardware/i2c.h>
+
+#include <string.h>
+
+// DREQ number of I2C0's transmit FIFO. The other I2C DREQs follow it.
+#define DREQ_I2C0_TX 32
+
+#define PICO_ERROR_GENERIC -1
+
+typedef struct {
+    bool started; // A transaction is in progress
+    bool acked; // The target of the transaction in progress answered
+} i2c_bus_t;
+
+static i2c_hw_t i2c_blocks[2];
+static i2c_bus_t buses[2];
+
+i2c_inst_t i2c0_inst = { &i2c_blocks[0], false };
+i2c_inst_t i2c1_inst = { &i2c_blocks[1], false };
+
+TwoWire Wire(i2c0);
+TwoWire Wire1(i2c1);
+
+namespace host {
+    bool oled_i2c_byte(uint block, uint8_t addr, uint8_t byte, bool start);
+    bool oled_i2c_read(uint block, uint8_t addr, uint8_t *dst, size_t len);
+
+    void reset_i2c() {
+        memset(i2c_blocks, 0, sizeof(i2c_blocks));
+        memset(buses, 0, sizeof(buses));
+    }
+
+    // Sends a byte to whichever device answers to addr. If none does, the transaction is aborted
+    // like the real controller does, and the rest of it is dropped.
+    static bool bus_write(uint block, uint8_t addr, uint8_t byte, bool stop) {
+        i2c_bus_t &bus = buses[block];
+        bool start = !bus.started;
+        bus.started = !stop;
+        if (start) {
+            bus.acked = oled_i2c_byte(block, addr, byte, true);
+            if (!bus.acked) {
+                i2c_blocks[block].raw_intr_stat |= I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+            }
+            return bus.acked;
+        }
+        if (bus.acked) {
+            oled_i2c_byte(block, addr, byte, false);
+        }
+        return bus.acked;
+    }
+
+    // Called for writes made by DMA, which go through the data/command register. Returns false if
+    // the address isn't the data/command register of an I2C block.
+    bool i2c_register_write(volatile void *addr, uint32_t value) {
+        for (uint block = 0; block < 2; block++) {
+            if (addr == &i2c_blocks[block].data_cmd) {
+                // Reads aren't simulated, and the controller discards writes until an abort is
+                // cleared.
+                if (!(value & I2C_IC_DATA_CMD_CMD_BITS) &&
+                    !(i2c_blocks[block].raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+                    bus_write(
+                        block,
+                        i2c_blocks[block].tar,
+                        value & 0xFF,
+                        value & I2C_IC_DATA_CMD_STOP_BITS
+                    );
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->hw->enable = 1;
+    return baudrate;
+}
+
+uint i2c_hw_index(i2c_inst_t *i2c) {
+    return i2c == i2c1 ? 1 : 0;
+}
+
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return DREQ_I2C0_TX + i2c_hw_index(i2c) * 2 + (is_tx ? 0 : 1);
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    uint block = i2c_hw_index(i2c);
+    for (size_t i = 0; i < len; i++) {
+        if (!host::bus_write(block, addr, src[i], !nostop && i == len - 1)) {
+            // The SDK clears the abort itself before returning.
+            buses[block].started = false;
+            i2c->hw->raw_intr_stat &= ~I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+            return PICO_ERROR_GENERIC;
+        }
+    }
+    return len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    uint block = i2c_hw_index(i2c);
+    // A read always starts a new transaction, or restarts the one in progress.
+    buses[block].started = nostop;
+    if (!host::oled_i2c_read(block, addr, dst, len)) {
+        memset(dst, 0, len);
+        buses[block].started = false;
+        return PICO_ERROR_GENERIC;
+    }
+    return len;
+}
+
+TwoWire::TwoWire(i2c_inst_t *i2c) {
+    _i2c = i2c;
+}
+
+bool TwoWire::setSDA(int pin) {
+    (void)pin;
+    return true;
+}
+
+bool TwoWire::setSCL(int pin) {
+    (void)pin;
+    return true;
+}
+
+void TwoWire::begin() {}
+
+void TwoWire::end() {}
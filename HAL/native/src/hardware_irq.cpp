@@ -0,0 +1,54 @@
+#include <hardware/irq.h>
+
+#include <string.h>
+
+#define IRQ_COUNT 32
+#define MAX_SHARED_HANDLERS 4
+
+typedef struct {
+    bool enabled;
+    irq_handler_t handlers[MAX_SHARED_HANDLERS];
+} irq_t;
+
+static irq_t irqs[IRQ_COUNT];
+
+namespace host {
+    void reset_irq() {
+        memset(irqs, 0, sizeof(irqs));
+    }
+
+    // Runs the handlers of an interrupt straight away, as if it was raised with nothing else
+    // running.
+    void raise_irq(uint num) {
+        if (!irqs[num].enabled) {
+            return;
+        }
+        for (irq_handler_t handler : irqs[num].handlers) {
+            if (handler != nullptr) {
+                handler();
+            }
+        }
+    }
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    for (irq_handler_t &slot : irqs[num].handlers) {
+        if (slot == nullptr) {
+            slot = handler;
+            return;
+        }
+    }
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler) {
+    for (irq_handler_t &slot : irqs[num].handlers) {
+        if (slot == handler) {
+            slot = nullptr;
+        }
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    irqs[num].enabled = enabled;
+}
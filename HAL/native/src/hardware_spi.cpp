@@ -0,0 +1,84 @@
+#include <hardware/spi.h>
+
+#include <string.h>
+
+// DREQ number of SPI0's transmit FIFO. The other SPI DREQs follow it.
+#define DREQ_SPI0_TX 16
+
+static spi_hw_t spi_blocks[2];
+static size_t blocking_bytes = 0;
+
+spi_inst_t spi0_inst = { &spi_blocks[0] };
+spi_inst_t spi1_inst = { &spi_blocks[1] };
+
+namespace host {
+    void oled_spi_byte(uint block, uint8_t byte);
+    void dma_spi_received(uint block);
+
+    void reset_spi() {
+        memset(spi_blocks, 0, sizeof(spi_blocks));
+        blocking_bytes = 0;
+    }
+
+    size_t spi_blocking_bytes() {
+        return blocking_bytes;
+    }
+
+    // Called for writes made by DMA. Returns false if the address isn't the data register of an
+    // SPI block.
+    bool spi_register_write(volatile void *addr, uint32_t value) {
+        for (uint block = 0; block < 2; block++) {
+            if (addr == &spi_blocks[block].dr) {
+                oled_spi_byte(block, value & 0xFF);
+                dma_spi_received(block);
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+uint spi_init(spi_inst_t *spi, uint baudrate) {
+    (void)spi;
+    return baudrate;
+}
+
+void spi_set_format(
+    spi_inst_t *spi,
+    uint data_bits,
+    spi_cpol_t cpol,
+    spi_cpha_t cpha,
+    spi_order_t order
+) {
+    (void)spi;
+    (void)data_bits;
+    (void)cpol;
+    (void)cpha;
+    (void)order;
+}
+
+spi_hw_t *spi_get_hw(spi_inst_t *spi) {
+    return spi->hw;
+}
+
+uint spi_get_index(spi_inst_t *spi) {
+    return spi == spi1 ? 1 : 0;
+}
+
+uint spi_get_dreq(spi_inst_t *spi, bool is_tx) {
+    return DREQ_SPI0_TX + spi_get_index(spi) * 2 + (is_tx ? 0 : 1);
+}
+
+bool spi_is_busy(spi_inst_t *spi) {
+    (void)spi;
+    return false;
+}
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        host::oled_spi_byte(spi_get_index(spi), src[i]);
+        host::dma_spi_received(spi_get_index(spi));
+        blocking_bytes++;
+    }
+    return len;
+}
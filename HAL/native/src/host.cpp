@@ -0,0 +1,28 @@
+#include "host.hpp"
+
+namespace host {
+    void reset_dma();
+    void reset_gpio();
+    void reset_i2c();
+    void reset_irq();
+    void reset_joybus();
+    void reset_oled();
+    void reset_serial();
+    void reset_spi();
+    void reset_storage();
+    void reset_usb();
+
+    void reset() {
+        set_micros(0);
+        reset_dma();
+        reset_gpio();
+        reset_i2c();
+        reset_irq();
+        reset_joybus();
+        reset_oled();
+        reset_serial();
+        reset_spi();
+        reset_storage();
+        reset_usb();
+    }
+}
@@ -0,0 +1,92 @@
+#include <GamecubeConsole.hpp>
+#include <N64Console.hpp>
+
+#include "host.hpp"
+
+#define MAX_PROBES 8
+
+pio_hw_t pio_blocks[2] = { { 0 }, { 1 } };
+
+static ConnectedConsole console = ConnectedConsole::NONE;
+static ConnectedConsole probes[MAX_PROBES];
+static size_t probe_count = 0;
+
+// Console instances don't claim PIO program space on the host, so every instance gets the same
+// offset.
+#define PROGRAM_OFFSET 0
+
+static bool probe(ConnectedConsole type) {
+    if (probe_count < MAX_PROBES) {
+        probes[probe_count++] = type;
+    }
+    return console == type;
+}
+
+namespace host {
+    void set_joybus_console(ConnectedConsole connected) {
+        console = connected;
+    }
+
+    size_t joybus_probes(ConnectedConsole *order, size_t max_len) {
+        size_t count = probe_count < max_len ? probe_count : max_len;
+        memcpy(order, probes, count * sizeof(ConnectedConsole));
+        return probe_count;
+    }
+
+    void reset_joybus() {
+        console = ConnectedConsole::NONE;
+        probe_count = 0;
+    }
+}
+
+GamecubeConsole::GamecubeConsole(uint pin, PIO pio, int sm, int offset) {
+    (void)pin;
+    (void)pio;
+    (void)sm;
+    _offset = offset >= 0 ? offset : PROGRAM_OFFSET;
+}
+
+GamecubeConsole::~GamecubeConsole() {}
+
+bool GamecubeConsole::Detect() {
+    return probe(ConnectedConsole::GAMECUBE);
+}
+
+void GamecubeConsole::WaitForPoll() {}
+
+void GamecubeConsole::WaitForPollStart() {}
+
+PollStatus GamecubeConsole::WaitForPollEnd() {
+    return PollStatus::RUMBLE_OFF;
+}
+
+void GamecubeConsole::SendReport(gc_report_t *report) {
+    (void)report;
+}
+
+int GamecubeConsole::GetOffset() {
+    return _offset;
+}
+
+N64Console::N64Console(uint pin, PIO pio, int sm, int offset) {
+    (void)pin;
+    (void)pio;
+    (void)sm;
+    _offset = offset >= 0 ? offset : PROGRAM_OFFSET;
+}
+
+N64Console::~N64Console() {}
+
+bool N64Console::Detect() {
+    return probe(ConnectedConsole::N64);
+}
+
+void N64Console::WaitForPoll() {}
+
+void N64Console::SendReport(n64_report_t *report) {
+    (void)report;
+}
+
+int N64Console::GetOffset() {
+    return _offset;
+}
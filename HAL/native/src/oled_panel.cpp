@@ -0,0 +1,149 @@
+#include "host.hpp"
+
+#include <hardware/gpio.h>
+#include <hardware/i2c.h>
+#include <hardware/spi.h>
+
+#include <string.h>
+
+#define NO_BUS 0xFF
+#define OLED_SSD1306_STATUS 0x06
+
+typedef struct {
+    uint8_t memory[OLED_PANEL_PAGES][OLED_PANEL_COLUMNS];
+    size_t data_bytes;
+
+    // Where the panel is connected. NO_BUS if it isn't on that kind of bus.
+    uint8_t i2c_block;
+    uint8_t i2c_address;
+    uint8_t spi_block;
+    uint cs_pin;
+    uint dc_pin;
+
+    uint8_t page;
+    uint8_t column;
+    // Parameter bytes still to come for the last command, which aren't commands themselves.
+    uint8_t parameters;
+
+    // I2C only. Each transaction starts with a control byte saying whether commands or data
+    // follow, and whether another control byte comes after the next byte.
+    bool expect_control;
+    bool data_mode;
+    bool single;
+} oled_panel_t;
+
+static oled_panel_t panel;
+
+namespace host {
+    void reset_oled() {
+        memset(&panel, 0, sizeof(panel));
+        panel.i2c_block = NO_BUS;
+        panel.spi_block = NO_BUS;
+    }
+
+    void attach_oled_i2c(i2c_inst_t *i2c, uint8_t address) {
+        panel.i2c_block = i2c_hw_index(i2c);
+        panel.i2c_address = address;
+    }
+
+    void attach_oled_spi(spi_inst_t *spi, uint cs_pin, uint dc_pin) {
+        panel.spi_block = spi_get_index(spi);
+        panel.cs_pin = cs_pin;
+        panel.dc_pin = dc_pin;
+    }
+
+    size_t oled_memory(uint8_t *memory, size_t max_len) {
+        size_t len = max_len < sizeof(panel.memory) ? max_len : sizeof(panel.memory);
+        memcpy(memory, panel.memory, len);
+        return len;
+    }
+
+    size_t oled_data_bytes() {
+        return panel.data_bytes;
+    }
+
+    // Number of parameter bytes that follow an SSD1306/SH1106 command.
+    static uint8_t parameter_count(uint8_t command) {
+        switch (command) {
+            case 0x20: // Memory addressing mode
+            case 0x81: // Contrast
+            case 0x8D: // Charge pump
+            case 0xA8: // Multiplex ratio
+            case 0xAD: // SH1106 DC-DC control
+            case 0xD3: // Display offset
+            case 0xD5: // Clock divide
+            case 0xD9: // Pre-charge period
+            case 0xDA: // COM pins
+            case 0xDB: // VCOMH level
+                return 1;
+            case 0x21: // Column address range
+            case 0x22: // Page address range
+            case 0xA3: // Vertical scroll area
+                return 2;
+            default:
+                return 0;
+        }
+    }
+
+    static void receive(uint8_t byte, bool data) {
+        if (data) {
+            if (panel.column < OLED_PANEL_COLUMNS && panel.page < OLED_PANEL_PAGES) {
+                panel.memory[panel.page][panel.column] = byte;
+            }
+            panel.column++;
+            panel.data_bytes++;
+            return;
+        }
+
+        // Only the addressing commands change what ends up in memory, so the rest are skipped.
+        if (panel.parameters > 0) {
+            panel.parameters--;
+        } else if (byte <= 0x0F) {
+            panel.column = (panel.column & 0xF0) | byte;
+        } else if (byte <= 0x1F) {
+            panel.column = (panel.column & 0x0F) | ((byte & 0x0F) << 4);
+        } else if (byte >= 0xB0 && byte <= 0xB7) {
+            panel.page = byte & 0x07;
+        } else {
+            panel.parameters = parameter_count(byte);
+        }
+    }
+
+    bool oled_i2c_byte(uint block, uint8_t addr, uint8_t byte, bool start) {
+        if (block != panel.i2c_block || addr != panel.i2c_address) {
+            return false;
+        }
+        if (start) {
+            panel.expect_control = true;
+        }
+        if (panel.expect_control) {
+            panel.single = byte & 0x80;
+            panel.data_mode = byte & 0x40;
+            panel.expect_control = false;
+            return true;
+        }
+        receive(byte, panel.data_mode);
+        panel.expect_control = panel.single;
+        return true;
+    }
+
+    // The panel only has its status byte to read. The low bits are what a 128x64 SSD1306 reports,
+    // which is how OneBitDisplay tells it from an SH1106.
+    bool oled_i2c_read(uint block, uint8_t addr, uint8_t *dst, size_t len) {
+        if (block != panel.i2c_block || addr != panel.i2c_address) {
+            return false;
+        }
+        memset(dst, 0, len);
+        if (len > 0) {
+            dst[0] = OLED_SSD1306_STATUS;
+        }
+        return true;
+    }
+
+    void oled_spi_byte(uint block, uint8_t byte) {
+        if (block != panel.spi_block || gpio_get(panel.cs_pin)) {
+            return;
+        }
+        receive(byte, gpio_get(panel.dc_pin));
+    }
+}
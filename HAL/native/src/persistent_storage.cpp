@@ -0,0 +1,95 @@
+#include "persistent_storage.hpp"
+
+#include "host.hpp"
+
+#define STORAGE_SIZE 256
+
+typedef struct {
+    uint addr;
+    size_t size;
+} staged_record_t;
+
+static uint8_t storage[STORAGE_SIZE];
+static size_t commits = 0;
+
+static uint8_t staged_data[STORAGE_SIZE];
+static staged_record_t staged_records[STORAGE_MAX_STAGED];
+static size_t staged_count = 0;
+
+namespace host {
+    size_t storage_commits() {
+        return commits;
+    }
+
+    void reset_storage() {
+        memset(storage, 0xFF, sizeof(storage));
+        commits = 0;
+        staged_count = 0;
+    }
+}
+
+namespace persistent_storage {
+    // Copies a record into storage. Returns true if it differed from the stored record.
+    static bool put(uint addr, uint8_t magic, const uint8_t *data, size_t size) {
+        if (storage[addr] == magic && memcmp(&storage[addr + 1], data, size) == 0) {
+            return false;
+        }
+        storage[addr] = magic;
+        memcpy(&storage[addr + 1], data, size);
+        return true;
+    }
+
+    bool read(uint addr, uint8_t magic, void *data, size_t size) {
+        if (addr + 1 + size > STORAGE_SIZE || storage[addr] != magic) {
+            return false;
+        }
+        memcpy(data, &storage[addr + 1], size);
+        return true;
+    }
+
+    void write(uint addr, uint8_t magic, const void *data, size_t size) {
+        if (addr + 1 + size > STORAGE_SIZE) {
+            return;
+        }
+        if (put(addr, magic, (const uint8_t *)data, size)) {
+            commits++;
+        }
+    }
+
+    bool stage(uint addr, uint8_t magic, const void *data, size_t size) {
+        if (addr + 1 + size > STORAGE_SIZE) {
+            return false;
+        }
+        size_t i = 0;
+        while (i < staged_count && staged_records[i].addr != addr) {
+            i++;
+        }
+        if (i >= STORAGE_MAX_STAGED) {
+            return false;
+        }
+        staged_records[i] = { addr, size };
+        staged_data[addr] = magic;
+        memcpy(&staged_data[addr + 1], data, size);
+        if (i == staged_count) {
+            staged_count = i + 1;
+        }
+        return true;
+    }
+
+    bool staged() {
+        return staged_count > 0;
+    }
+
+    void commit_staged() {
+        bool changed = false;
+        for (size_t i = 0; i < staged_count; i++) {
+            uint addr = staged_records[i].addr;
+            changed |=
+                put(addr, staged_data[addr], &staged_data[addr + 1], staged_records[i].size);
+        }
+        if (changed) {
+            commits++;
+        }
+        staged_count = 0;
+    }
+}
@@ -0,0 +1,100 @@
+#include "serial.hpp"
+
+#include "host.hpp"
+#include "stdlib.hpp"
+
+#define SERIAL_BUFFER_SIZE 65536
+
+static bool port_open = false;
+static bool host_connected = true;
+static int write_space = SERIAL_BUFFER_SIZE;
+
+static uint8_t output[SERIAL_BUFFER_SIZE];
+static size_t output_len = 0;
+
+static uint8_t input[SERIAL_BUFFER_SIZE];
+static size_t input_head = 0;
+static size_t input_tail = 0;
+
+namespace host {
+    void set_serial_connected(bool connected) {
+        host_connected = connected;
+    }
+
+    void set_serial_write_space(int bytes) {
+        write_space = bytes;
+    }
+
+    void queue_serial_input(const uint8_t *bytes, size_t len) {
+        for (size_t i = 0; i < len && input_tail < SERIAL_BUFFER_SIZE; i++) {
+            input[input_tail++] = bytes[i];
+        }
+    }
+
+    size_t serial_output(uint8_t *bytes, size_t max_len) {
+        size_t len = output_len < max_len ? output_len : max_len;
+        memcpy(bytes, output, len);
+        return len;
+    }
+
+    void clear_serial_output() {
+        output_len = 0;
+    }
+
+    void reset_serial() {
+        port_open = false;
+        host_connected = true;
+        write_space = SERIAL_BUFFER_SIZE;
+        output_len = 0;
+        input_head = 0;
+        input_tail = 0;
+    }
+}
+
+namespace serial {
+    void init(unsigned long baudrate) {
+        (void)baudrate;
+        port_open = true;
+    }
+
+    void close() {
+        port_open = false;
+    }
+
+    void print(const char *string) {
+        write((uint8_t *)string, strlen(string));
+    }
+
+    void write(uint8_t byte) {
+        write(&byte, 1);
+    }
+
+    void write(uint8_t *bytes, size_t len) {
+        // Like the USB CDC port, anything written while the port isn't port_open is dropped.
+        if (!port_open) {
+            return;
+        }
+        for (size_t i = 0; i < len && output_len < SERIAL_BUFFER_SIZE; i++) {
+            output[output_len++] = bytes[i];
+        }
+    }
+
+    int available_for_write() {
+        return port_open ? write_space : 0;
+    }
+
+    int available() {
+        return port_open ? input_tail - input_head : 0;
+    }
+
+    int read() {
+        if (!port_open || input_head == input_tail) {
+            return -1;
+        }
+        return input[input_head++];
+    }
+
+    bool connected() {
+        return port_open && host_connected;
+    }
+}
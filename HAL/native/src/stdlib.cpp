@@ -0,0 +1,67 @@
+#include "stdlib.hpp"
+
+#include "host.hpp"
+
+static uint64_t now_us = 0;
+
+namespace host {
+    void set_micros(uint64_t us) {
+        now_us = us;
+    }
+
+    void advance_micros(uint64_t us) {
+        now_us += us;
+    }
+}
+
+uint32_t micros() {
+    return (uint32_t)now_us;
+}
+
+uint32_t millis() {
+    return (uint32_t)(now_us / 1000);
+}
+
+void delay(uint32_t ms) {
+    now_us += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us) {
+    now_us += us;
+}
+
+uint32_t time_us_32() {
+    return (uint32_t)now_us;
+}
+
+uint64_t time_us_64() {
+    return now_us;
+}
+
+void sleep_ms(uint32_t ms) {
+    now_us += (uint64_t)ms * 1000;
+}
+
+void sleep_us(uint64_t us) {
+    now_us += us;
+}
+
+void busy_wait_us(uint64_t us) {
+    now_us += us;
+}
+
+void busy_wait_us_32(uint32_t us) {
+    now_us += us;
+}
+
+absolute_time_t get_absolute_time() {
+    return now_us;
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+void tight_loop_contents() {
+    now_us++;
+}
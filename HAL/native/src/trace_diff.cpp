@@ -0,0 +1,42 @@
+#include "trace_diff.hpp"
+
+#include "core/ControllerMode.hpp"
+#include "core/TraceRecorder.hpp"
+#include "input/ReplayInput.hpp"
+
+size_t trace_diff(
+    ControllerMode &mode,
+    const trace_record_t *records,
+    size_t record_count,
+    trace_mismatch_t *mismatches,
+    size_t max_mismatches
+) {
+    ReplayInput replay(records, record_count);
+    InputState inputs;
+    size_t mismatch_count = 0;
+
+    for (size_t i = 0; i < record_count; i++) {
+        // Same order of operations as CommunicationBackend::UpdateOutputs().
+        replay.UpdateInputs(inputs);
+        OutputState outputs;
+        mode.UpdateOutputs(inputs, outputs);
+
+        OutputState expected;
+        replay.ExpectedOutputs(expected);
+        if (outputs_equal(expected, outputs)) {
+            continue;
+        }
+
+        if (mismatches != nullptr && mismatch_count < max_mismatches) {
+            mismatches[mismatch_count] = { i, records[i].sequence, expected, outputs };
+        }
+        mismatch_count++;
+    }
+
+    return mismatch_count;
+}
+
+bool outputs_equal(const OutputState &a, const OutputState &b) {
+    // Every field is a single byte, so there is no padding to trip up a byte comparison.
+    return memcmp(&a, &b, sizeof(OutputState)) == 0;
+}
@@ -9,9 +9,12 @@
 
 class DInputBackend : public CommunicationBackend {
   public:
+    static constexpr BackendInfo info = { BackendId::DINPUT, "DINPUT" };
+
     DInputBackend(InputSource **input_sources, size_t input_source_count);
     ~DInputBackend();
     void SendReport();
+    const BackendInfo &Info() { return info; }
 
   private:
     TUGamepad *_gamepad;
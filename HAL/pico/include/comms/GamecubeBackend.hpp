@@ -1,6 +1,7 @@
 #ifndef _COMMS_GAMECUBEBACKEND_HPP
 #define _COMMS_GAMECUBEBACKEND_HPP
 
+#include "comms/JoybusLink.hpp"
 #include "core/CommunicationBackend.hpp"
 
 #include <GamecubeConsole.hpp>
@@ -8,6 +9,8 @@
 
 class GamecubeBackend : public CommunicationBackend {
   public:
+    static constexpr BackendInfo info = { BackendId::GAMECUBE, "GCN" };
+
     GamecubeBackend(
         InputSource **input_sources,
         size_t input_source_count,
@@ -16,13 +19,22 @@ class GamecubeBackend : public CommunicationBackend {
         int sm = -1,
         int offset = -1
     );
+    GamecubeBackend(InputSource **input_sources, size_t input_source_count, GamecubeLink *link);
     ~GamecubeBackend();
     void SendReport();
+    const BackendInfo &Info() { return info; }
     int GetOffset();
 
+    // Copies the most recently sent report. Safe to call from the other core.
+    void GetLastReport(gc_report_t &report);
+
   private:
-    GamecubeConsole *_gamecube;
-    gc_report_t _report;
+    GamecubeLink *_gamecube;
+
+    // Reports are double buffered so that a mirror port on the other core can copy the last sent
+    // report while the next one is being built.
+    gc_report_t _reports[2];
+    volatile uint8_t _published = 0;
 };
 
 #endif
@@ -0,0 +1,38 @@
+#ifndef _COMMS_GAMECUBEMIRRORBACKEND_HPP
+#define _COMMS_GAMECUBEMIRRORBACKEND_HPP
+
+#include "comms/GamecubeBackend.hpp"
+#include "comms/JoybusLink.hpp"
+#include "core/CommunicationBackend.hpp"
+
+#include <GamecubeConsole.hpp>
+#include <hardware/pio.h>
+
+/**
+ * Serves a second GameCube port, e.g. a capture adapter, with the reports computed by a primary
+ * GamecubeBackend. The port has its own PIO state machine and answers polls on its own timing, so
+ * it is meant to be run from the other core. No inputs are scanned and no mode logic is run.
+ */
+class GamecubeMirrorBackend : public CommunicationBackend {
+  public:
+    static constexpr BackendInfo info = { BackendId::GAMECUBE_MIRROR, "MIRROR" };
+
+    GamecubeMirrorBackend(
+        GamecubeBackend *source,
+        uint data_pin,
+        PIO pio = pio1,
+        int sm = -1,
+        int offset = -1
+    );
+    GamecubeMirrorBackend(GamecubeBackend *source, GamecubeLink *link);
+    ~GamecubeMirrorBackend();
+    void SendReport();
+    const BackendInfo &Info() { return info; }
+
+  private:
+    GamecubeBackend *_source;
+    GamecubeLink *_gamecube;
+    gc_report_t _report;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef _COMMS_JOYBUSLINK_HPP
+#define _COMMS_JOYBUSLINK_HPP
+
+#include <GamecubeConsole.hpp>
+#include <N64Console.hpp>
+
+/**
+ * The console end of a GameCube port, as seen by a backend. PioGamecubeLink talks to a real console
+ * through joybus-pio, and the native build has a stand-in console that issues polls on a simulated
+ * clock.
+ */
+class GamecubeLink {
+  public:
+    virtual ~GamecubeLink(){};
+
+    // Returns once the start of a poll has been received. Other commands, like probe and origin,
+    // are answered without returning.
+    virtual void WaitForPollStart() = 0;
+    // Returns once the rest of the poll has been received, at which point the reply is due.
+    virtual PollStatus WaitForPollEnd() = 0;
+    virtual void SendReport(gc_report_t *report) = 0;
+
+    // Offset of the PIO program in instruction memory, or -1 if the link doesn't use one.
+    virtual int GetOffset() = 0;
+};
+
+// The console end of an N64 port. See GamecubeLink.
+class N64Link {
+  public:
+    virtual ~N64Link(){};
+
+    // Returns once a whole poll has been received, at which point the reply is due.
+    virtual void WaitForPoll() = 0;
+    virtual void SendReport(n64_report_t *report) = 0;
+
+    virtual int GetOffset() = 0;
+};
+
+#endif
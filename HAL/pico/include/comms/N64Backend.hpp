@@ -1,6 +1,7 @@
 #ifndef _COMMS_N64BACKEND_HPP
 #define _COMMS_N64BACKEND_HPP
 
+#include "comms/JoybusLink.hpp"
 #include "core/CommunicationBackend.hpp"
 
 #include <N64Console.hpp>
@@ -8,6 +9,8 @@
 
 class N64Backend : public CommunicationBackend {
   public:
+    static constexpr BackendInfo info = { BackendId::N64, "N64" };
+
     N64Backend(
         InputSource **input_sources,
         size_t input_source_count,
@@ -16,13 +19,21 @@ class N64Backend : public CommunicationBackend {
         int sm = -1,
         int offset = -1
     );
+    N64Backend(InputSource **input_sources, size_t input_source_count, N64Link *link);
     ~N64Backend();
+    void SetGameMode(ControllerMode *gamemode);
+
+    // Selects the full deflection of the stick sent to the N64, N64_STICK_RANGE by default. Games
+    // tuned for a new OEM stick may want a little more, e.g. 85.
+    void SetStickRange(uint8_t range);
     void SendReport();
+    const BackendInfo &Info() { return info; }
     int GetOffset();
 
   private:
-    N64Console *_n64;
+    N64Link *_n64;
     n64_report_t _report;
+    uint8_t _stick_range = N64_STICK_RANGE;
 };
 
 #endif
@@ -41,12 +41,15 @@ typedef struct __attribute__((packed, aligned(1))) {
 
 class NintendoSwitchBackend : public CommunicationBackend {
   public:
+    static constexpr BackendInfo info = { BackendId::NINTENDO_SWITCH, "SWITCH" };
+
     NintendoSwitchBackend(InputSource **input_sources, size_t input_source_count);
     ~NintendoSwitchBackend();
 
     static void RegisterDescriptor();
 
     void SendReport();
+    const BackendInfo &Info() { return info; }
 
   protected:
     static const uint8_t _report_id = 0;
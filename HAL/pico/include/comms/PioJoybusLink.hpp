@@ -0,0 +1,36 @@
+#ifndef _COMMS_PIOJOYBUSLINK_HPP
+#define _COMMS_PIOJOYBUSLINK_HPP
+
+#include "comms/JoybusLink.hpp"
+
+#include <GamecubeConsole.hpp>
+#include <N64Console.hpp>
+
+// Talks to a real GameCube through joybus-pio. Takes ownership of the console instance.
+class PioGamecubeLink : public GamecubeLink {
+  public:
+    PioGamecubeLink(GamecubeConsole *gamecube);
+    ~PioGamecubeLink();
+    void WaitForPollStart();
+    PollStatus WaitForPollEnd();
+    void SendReport(gc_report_t *report);
+    int GetOffset();
+
+  private:
+    GamecubeConsole *_gamecube;
+};
+
+// Talks to a real N64 through joybus-pio. Takes ownership of the console instance.
+class PioN64Link : public N64Link {
+  public:
+    PioN64Link(N64Console *n64);
+    ~PioN64Link();
+    void WaitForPoll();
+    void SendReport(n64_report_t *report);
+    int GetOffset();
+
+  private:
+    N64Console *_n64;
+};
+
+#endif
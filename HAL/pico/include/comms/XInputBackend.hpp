@@ -9,9 +9,12 @@
 
 class XInputBackend : public CommunicationBackend {
   public:
+    static constexpr BackendInfo info = { BackendId::XINPUT, "XINPUT" };
+
     XInputBackend(InputSource **input_sources, size_t input_source_count);
     ~XInputBackend();
     void SendReport();
+    const BackendInfo &Info() { return info; }
 
   private:
     Adafruit_USBD_XInput *_xinput;
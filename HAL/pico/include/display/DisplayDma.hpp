@@ -0,0 +1,96 @@
+#ifndef _DISPLAY_DISPLAYDMA_HPP
+#define _DISPLAY_DISPLAYDMA_HPP
+
+#include "stdlib.hpp"
+
+#include <hardware/i2c.h>
+#include <hardware/spi.h>
+#include <lib/OneBitDisplay/OneBitDisplay.h>
+
+// Enough for every page of a 128 pixel wide panel in one transfer, including the 4 byte position
+// command and the data introducer in front of each page.
+#define DISPLAY_DMA_BUFFER_SIZE (8 * (128 + 5))
+
+// Most runs a transfer can hold on SPI. With 8 tiles per page there are at most 4 runs per page.
+#define DISPLAY_DMA_MAX_RUNS 32
+
+/**
+ * Sends blocks of display memory to an OLED on the RP2040's hardware I2C or SPI block using DMA, so
+ * that core1 is free to do other work while the panel is being written.
+ *
+ * Runs of display memory are queued with AddRun() and then all sent by Start().
+ *
+ * On I2C, each byte is stored as a word for the I2C block's data/command register, with the STOP
+ * bit set on the last byte of each I2C transaction, so the controller splits a single DMA transfer
+ * into separate position and data transactions on its own. The block can be shared with other
+ * devices, such as the Nunchuk, through i2c_bus. A transfer is only started once the block is
+ * idle, and points it at the panel first.
+ *
+ * On SPI, the D/C pin has to change between the position command and the data of each run, which
+ * DMA can't do. Each run's command and data are sent as separate DMA transfers, and the completion
+ * interrupt changes D/C and starts the next one, so the runs are still sent in the background. A
+ * second channel reads back the bytes the SPI block receives while sending. It only finishes once
+ * the last byte has been shifted out, unlike the sending channel, which finishes when the last
+ * byte is in the FIFO, so its interrupt marks the point where D/C can change. The interrupt
+ * handler never waits for the bus.
+ */
+class DisplayDma {
+  public:
+    DisplayDma(OBDISP *obd);
+    ~DisplayDma();
+
+    // Whether the display's panel type and bus can be driven by this class.
+    static bool Supports(OBDISP *obd);
+
+    // True while a transfer is still being sent, or is still waiting for another device to finish
+    // with the I2C block. Nothing can be queued until it has finished.
+    bool Busy();
+    // True if the panel stopped acknowledging during the last transfer, meaning part of it was
+    // lost. Reading this clears it. Never true on SPI.
+    bool Aborted();
+    // Queues length bytes of display memory to be written starting at column x of the given page.
+    // Returns false if there is no room left for them in this transfer.
+    bool AddRun(int x, int page, const uint8_t *data, int length);
+    // Sends everything queued. If the I2C block is in use, the transfer is started by a later
+    // Busy() call instead.
+    void Start();
+
+  private:
+    typedef struct {
+        uint8_t command[3]; // Sets the page and column the run starts at
+        uint16_t offset;
+        uint16_t length;
+    } Run;
+
+    static DisplayDma *_spi_instance;
+
+    i2c_inst_t *_i2c = nullptr;
+    uint16_t _address;
+    spi_inst_t *_spi = nullptr;
+    uint _cs_pin;
+    uint _dc_pin;
+    int _column_offset;
+    uint _channel;
+    uint _rx_channel;
+    uint8_t _rx_discard;
+
+    uint16_t _buffer[DISPLAY_DMA_BUFFER_SIZE];
+    size_t _length = 0;
+
+    // On SPI the buffer only holds the data bytes, and the runs are kept separately.
+    Run _runs[DISPLAY_DMA_MAX_RUNS];
+    size_t _run_count = 0;
+    volatile size_t _next_run = 0;
+    volatile bool _spi_busy = false;
+    volatile bool _sending_command = false;
+
+    bool AddI2cRun(int x, int page, const uint8_t *data, int length);
+    bool AddSpiRun(int x, int page, const uint8_t *data, int length);
+    void SendSpi(const uint8_t *data, size_t length);
+    void StartSpiRun();
+    void StartSpiData();
+
+    static void HandleSpiIrq();
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef _DISPLAY_FRAMESCHEDULER_HPP
+#define _DISPLAY_FRAMESCHEDULER_HPP
+
+#include "stdlib.hpp"
+
+/**
+ * Paces display refreshes to a fixed frame rate. Frames are due at fixed intervals, and if the loop
+ * gets to a frame more than a whole interval late, the frames in between are skipped rather than
+ * drawn back to back, so rendering can never take more than its share of the loop.
+ *
+ * Times are passed in rather than read from a clock, so this doesn't depend on the platform.
+ */
+class FrameScheduler {
+  public:
+    FrameScheduler(uint32_t frame_rate);
+
+    // Returns true if a frame should be drawn now. Counts any frames that were missed since the
+    // last one as skipped.
+    bool FrameDue(uint32_t now_us);
+    // Records that the frame started by the last call to FrameDue() has been drawn.
+    void FrameDone(uint32_t now_us);
+    // Records that the frame started by the last call to FrameDue() couldn't be drawn.
+    void SkipFrame();
+
+    uint32_t FramesDrawn();
+    uint32_t FramesSkipped();
+    // Time taken to draw the last frame, and the longest time taken by any frame.
+    uint32_t FrameTime();
+    uint32_t MaxFrameTime();
+
+  private:
+    uint32_t _period_us;
+    uint32_t _next_frame_us = 0;
+    uint32_t _frame_start_us = 0;
+    bool _started = false;
+
+    uint32_t _frames_drawn = 0;
+    uint32_t _frames_skipped = 0;
+    uint32_t _frame_time_us = 0;
+    uint32_t _max_frame_time_us = 0;
+};
+
+#endif
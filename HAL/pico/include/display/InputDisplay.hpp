@@ -0,0 +1,112 @@
+#ifndef _DISPLAY_INPUTDISPLAY_HPP
+#define _DISPLAY_INPUTDISPLAY_HPP
+
+#include "core/state.hpp"
+#include "display/DisplayDma.hpp"
+#include "stdlib.hpp"
+
+#include <lib/OneBitDisplay/OneBitDisplay.h>
+
+#define INPUT_DISPLAY_MAX_BUTTONS 32
+
+// The panel is updated in tiles of 16 columns by one 8 pixel page.
+#define INPUT_DISPLAY_TILE_WIDTH 16
+
+// Widest a label can be rendered.
+#define INPUT_DISPLAY_MAX_LABEL_WIDTH 128
+
+// Largest width/height of a button sprite.
+#define INPUT_DISPLAY_SPRITE_SIZE 9
+
+enum class ButtonShape {
+    CIRCLE, // 9x9 circle centered on x, y
+    SQUARE, // 7x7 square with its top left corner at x, y
+    SHAPE_COUNT,
+};
+
+typedef struct {
+    bool InputState::*input;
+    ButtonShape shape;
+    uint8_t x;
+    uint8_t y;
+} DisplayButton;
+
+typedef struct {
+    const DisplayButton *buttons;
+    size_t button_count;
+} ButtonLayout;
+
+enum DisplayLabel {
+    LABEL_LEFT,
+    LABEL_CENTER,
+    LABEL_RIGHT,
+    LABEL_COUNT,
+};
+
+/**
+ * Draws the input viewer and labels on an OLED display. Only buttons whose state changed since the
+ * last update are redrawn, and only the tiles of the panel that were drawn to are sent to it, so in
+ * steady state an update does nothing at all.
+ *
+ * Button shapes are rasterized once into a sprite atlas when the display is created, using the same
+ * OneBitDisplay primitives as before, so drawing a button is only a masked blit of a few columns.
+ * Likewise, each label is rendered off-screen once when it is set, and the top row is put together
+ * from the rendered labels, with only the tiles whose contents actually changed sent to the panel.
+ *
+ * On a hardware I2C panel the changed tiles are sent in the background with DMA. While a transfer
+ * is still in progress, updates only draw into the back buffer and the tiles they touch are sent
+ * with the next transfer.
+ */
+class InputDisplay {
+  public:
+    // The display must have a back buffer, and its contents must match what is on the panel.
+    InputDisplay(OBDISP *obd);
+    void AddButtons(const DisplayButton *buttons, size_t button_count);
+    void AddLayout(const ButtonLayout &layout);
+    // Labels are compared by pointer, so the text must stay valid and unchanged while it is shown.
+    void SetLabel(DisplayLabel label, const char *text);
+    // Replaces a whole 8 pixel row below the labels with a line of text. Unlike labels, this draws
+    // straight away, so only call it when the text changes.
+    void DrawText(int row, const char *text);
+    // Draws a rectangle outline, or a filled rectangle, straight away. Pixels are lit if color is
+    // true and cleared otherwise.
+    void DrawRect(int x1, int y1, int x2, int y2, bool color, bool fill);
+    void Update(InputState &inputs);
+    // False while the last update is still being sent to the panel in the background, or while
+    // another device is using the display's I2C block.
+    bool Ready();
+
+  private:
+    OBDISP *_obd;
+    DisplayDma *_dma = nullptr;
+
+    const DisplayButton *_buttons[INPUT_DISPLAY_MAX_BUTTONS];
+    size_t _button_count = 0;
+    bool _drawn_pressed[INPUT_DISPLAY_MAX_BUTTONS];
+    bool _drawn[INPUT_DISPLAY_MAX_BUTTONS];
+
+    const char *_labels[LABEL_COUNT] = {};
+    bool _labels_dirty = true;
+    // Each label as rendered by OneBitDisplay, one byte per column.
+    uint8_t _label_columns[LABEL_COUNT][INPUT_DISPLAY_MAX_LABEL_WIDTH];
+    uint8_t _label_widths[LABEL_COUNT] = {};
+
+    // One bit per tile, one byte per page.
+    uint8_t _dirty_tiles[8] = {};
+
+    // Button sprites stored as one bit per row for each column, indexed by shape and pressed state.
+    uint16_t _sprites[(int)ButtonShape::SHAPE_COUNT][2][INPUT_DISPLAY_SPRITE_SIZE];
+
+    void RasterizeSprites();
+    void Blit(const uint16_t *columns, int x, int y, int width, int height, bool opaque);
+
+    void DrawButton(size_t index, bool pressed, bool erase);
+    void RenderLabel(DisplayLabel label);
+    void DrawLabels();
+    void MarkDirty(int x1, int y1, int x2, int y2);
+    void Flush();
+
+    static void GetBounds(const DisplayButton &button, int &x1, int &y1, int &x2, int &y2);
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _DISPLAY_POLLSTATSPAGE_HPP
+#define _DISPLAY_POLLSTATSPAGE_HPP
+
+#include "core/PollStats.hpp"
+#include "display/InputDisplay.hpp"
+#include "stdlib.hpp"
+
+#define POLL_STATS_PAGE_LINES 4
+// 21 characters fit across a 128 pixel display.
+#define POLL_STATS_PAGE_LINE_LENGTH 22
+
+/**
+ * Shows the primary backend's poll rate, latency, slack and skipped polls as lines of text under
+ * the labels, so the health of a setup can be checked without a PC. Lines are only redrawn when
+ * their text changes, which is at most once per PollStats window.
+ */
+class PollStatsPage {
+  public:
+    PollStatsPage(InputDisplay *display);
+    void Update(const poll_stats_t &stats);
+
+  private:
+    InputDisplay *_display;
+    char _lines[POLL_STATS_PAGE_LINES][POLL_STATS_PAGE_LINE_LENGTH] = {};
+
+    void SetLine(int line, const char *text);
+    static void FormatMicros(char *buffer, size_t size, uint32_t value_us);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef _DISPLAY_STICKDISPLAY_HPP
+#define _DISPLAY_STICKDISPLAY_HPP
+
+#include "core/state.hpp"
+#include "display/InputDisplay.hpp"
+#include "stdlib.hpp"
+
+// Side length of the box each stick is plotted in, including its border.
+#define STICK_DISPLAY_BOX_SIZE 40
+
+// 21 characters fit across a 128 pixel display.
+#define STICK_DISPLAY_LINE_LENGTH 22
+
+/**
+ * Plots the stick outputs computed by the active mode, so that modifier angles can be checked
+ * without a PC. Each stick gets a box with a dot at its current position, and the exact
+ * coordinates of both sticks are shown as text underneath.
+ *
+ * Only the dots are redrawn when a stick moves: the old dot is cleared and the new one drawn. The
+ * text line is only redrawn when one of the values changes.
+ */
+class StickDisplay {
+  public:
+    StickDisplay(InputDisplay *display);
+    void Update(const StickSnapshot &sticks);
+
+  private:
+    InputDisplay *_display;
+
+    // Dot position of each stick in screen coordinates, or -1 if it hasn't been drawn yet.
+    int _dot_x[2] = { -1, -1 };
+    int _dot_y[2] = { -1, -1 };
+
+    char _coordinates[STICK_DISPLAY_LINE_LENGTH] = {};
+
+    void MoveDot(int stick, uint8_t x, uint8_t y);
+    void DrawCenter(int stick);
+};
+
+#endif
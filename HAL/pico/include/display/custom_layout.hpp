@@ -0,0 +1,28 @@
+#ifndef _DISPLAY_CUSTOM_LAYOUT_HPP
+#define _DISPLAY_CUSTOM_LAYOUT_HPP
+
+#include "display/InputDisplay.hpp"
+#include "stdlib.hpp"
+
+#define CUSTOM_LAYOUT_HEADER 0xD1
+
+/*
+ * A user-defined input display layout, uploaded over USB serial with tools/upload_layout.py and
+ * stored in flash, so layouts can be changed without recompiling.
+ *
+ * Upload frame: header byte, button count, then for each button its input (an input_mask::InputBit),
+ * shape (a ButtonShape), x and y, followed by an XOR checksum of all preceding bytes.
+ */
+namespace custom_layout {
+    // Loads the stored custom layout. Returns false if there is none.
+    bool load(ButtonLayout &layout);
+
+    /**
+     * Consumes any bytes waiting on USB serial without blocking. Returns true once a complete,
+     * valid layout has been received and staged with persistent_storage::stage(). The caller
+     * decides when it is written to flash, and it is used from the next boot onwards.
+     */
+    bool receive();
+}
+
+#endif
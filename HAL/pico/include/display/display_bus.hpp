@@ -0,0 +1,43 @@
+#ifndef _DISPLAY_DISPLAY_BUS_HPP
+#define _DISPLAY_DISPLAY_BUS_HPP
+
+#include "stdlib.hpp"
+
+#include <hardware/i2c.h>
+#include <hardware/spi.h>
+#include <lib/OneBitDisplay/OneBitDisplay.h>
+
+enum class DisplayBus {
+    I2C,
+    SPI,
+};
+
+/*
+ * How a board's OLED display is wired up. Only the pins for the selected bus are used, and pins
+ * that aren't connected are set to -1.
+ */
+typedef struct {
+    DisplayBus bus;
+    int32_t speed; // Bus clock in Hz
+
+    // I2C
+    i2c_inst_t *i2c;
+    int sda;
+    int scl;
+    int address; // -1 to detect it
+
+    // SPI
+    spi_inst_t *spi;
+    int sck;
+    int mosi;
+    int cs;
+    int dc;
+    int reset;
+} DisplayPinout;
+
+namespace display_bus {
+    // Sets up the bus and initializes the display on it.
+    void init(OBDISP *obd, const DisplayPinout &pinout, int type, int flip, int invert);
+}
+
+#endif
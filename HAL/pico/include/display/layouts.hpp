@@ -0,0 +1,227 @@
+#ifndef _DISPLAY_LAYOUTS_HPP
+#define _DISPLAY_LAYOUTS_HPP
+
+#include "display/InputDisplay.hpp"
+
+/*
+ * Built in button layouts for the input display. Each side of the display has its own set of
+ * layouts, selected by enum so that the choice is resolved to a table once at boot.
+ */
+
+enum class LeftLayout {
+    CIRCLES,
+    SQUARES,
+    CIRCLES_WASD,
+    SQUARES_WASD,
+    HTANGL,
+};
+
+enum class CenterLayout {
+    CIRCLES,
+    CIRCLES_3_BUTTON,
+    SQUARES,
+    SQUARES_3_BUTTON,
+    HTANGL,
+};
+
+enum class RightLayout {
+    CIRCLES,
+    SQUARES,
+    CIRCLES_19_BUTTON,
+    SQUARES_19_BUTTON,
+    HTANGL,
+};
+
+namespace layouts {
+    constexpr DisplayButton left_circles[] = {
+        { &InputState::l,     ButtonShape::CIRCLE, 6, 29 },
+        { &InputState::left,  ButtonShape::CIRCLE, 15, 23 },
+        { &InputState::down,  ButtonShape::CIRCLE, 25, 22 },
+        { &InputState::right, ButtonShape::CIRCLE, 35, 27 },
+        { &InputState::mod_x, ButtonShape::CIRCLE, 38, 52 },
+        { &InputState::mod_y, ButtonShape::CIRCLE, 46, 58 },
+    };
+
+    constexpr DisplayButton left_squares[] = {
+        { &InputState::l,     ButtonShape::SQUARE, 3, 26 },
+        { &InputState::left,  ButtonShape::SQUARE, 12, 20 },
+        { &InputState::down,  ButtonShape::SQUARE, 22, 19 },
+        { &InputState::right, ButtonShape::SQUARE, 32, 24 },
+        { &InputState::mod_x, ButtonShape::SQUARE, 35, 49 },
+        { &InputState::mod_y, ButtonShape::SQUARE, 43, 55 },
+    };
+
+    constexpr DisplayButton left_circles_wasd[] = {
+        { &InputState::l,     ButtonShape::CIRCLE, 6, 29 },
+        { &InputState::left,  ButtonShape::CIRCLE, 15, 23 },
+        { &InputState::down,  ButtonShape::CIRCLE, 25, 22 },
+        { &InputState::up,    ButtonShape::CIRCLE, 29, 13 },
+        { &InputState::right, ButtonShape::CIRCLE, 35, 27 },
+        { &InputState::mod_x, ButtonShape::CIRCLE, 38, 52 },
+        { &InputState::mod_y, ButtonShape::CIRCLE, 46, 58 },
+    };
+
+    constexpr DisplayButton left_squares_wasd[] = {
+        { &InputState::l,     ButtonShape::SQUARE, 3, 26 },
+        { &InputState::left,  ButtonShape::SQUARE, 12, 20 },
+        { &InputState::down,  ButtonShape::SQUARE, 22, 19 },
+        { &InputState::right, ButtonShape::SQUARE, 32, 24 },
+        { &InputState::up,    ButtonShape::SQUARE, 26, 10 },
+        { &InputState::mod_x, ButtonShape::SQUARE, 35, 49 },
+        { &InputState::mod_y, ButtonShape::SQUARE, 43, 55 },
+    };
+
+    constexpr DisplayButton left_htangl[] = {
+        { &InputState::l,     ButtonShape::SQUARE, 3, 26 },
+        { &InputState::left,  ButtonShape::SQUARE, 12, 20 },
+        { &InputState::down,  ButtonShape::SQUARE, 22, 19 },
+        { &InputState::right, ButtonShape::SQUARE, 32, 24 },
+        { &InputState::mod_x, ButtonShape::SQUARE, 35, 49 },
+        { &InputState::mod_y, ButtonShape::SQUARE, 41, 55 },
+    };
+
+    constexpr DisplayButton center_circles[] = {
+        { &InputState::start, ButtonShape::CIRCLE, 64, 27 },
+    };
+
+    constexpr DisplayButton center_circles_3button[] = {
+        { &InputState::start,  ButtonShape::CIRCLE, 64, 27 },
+        { &InputState::select, ButtonShape::CIRCLE, 54, 27 },
+        { &InputState::home,   ButtonShape::CIRCLE, 74, 27 },
+    };
+
+    constexpr DisplayButton center_squares[] = {
+        { &InputState::start, ButtonShape::SQUARE, 61, 24 },
+    };
+
+    constexpr DisplayButton center_squares_3button[] = {
+        { &InputState::start,  ButtonShape::SQUARE, 61, 24 },
+        { &InputState::select, ButtonShape::SQUARE, 51, 24 },
+        { &InputState::home,   ButtonShape::SQUARE, 71, 24 },
+    };
+
+    constexpr DisplayButton center_htangl[] = {
+        { &InputState::select, ButtonShape::SQUARE, 50, 32 },
+        { &InputState::start,  ButtonShape::SQUARE, 61, 32 },
+        { &InputState::home,   ButtonShape::SQUARE, 72, 32 },
+    };
+
+    constexpr DisplayButton right_circles[] = {
+        { &InputState::c_left,      ButtonShape::CIRCLE, 82, 46 },
+        { &InputState::c_down,      ButtonShape::CIRCLE, 82, 58 },
+        { &InputState::c_up,        ButtonShape::CIRCLE, 90, 40 },
+        { &InputState::a,           ButtonShape::CIRCLE, 90, 52 },
+        { &InputState::c_right,     ButtonShape::CIRCLE, 98, 46 },
+        { &InputState::r,           ButtonShape::CIRCLE, 93, 17 },
+        { &InputState::b,           ButtonShape::CIRCLE, 93, 27 },
+        { &InputState::y,           ButtonShape::CIRCLE, 103, 13 },
+        { &InputState::x,           ButtonShape::CIRCLE, 102, 23 },
+        { &InputState::lightshield, ButtonShape::CIRCLE, 113, 14 },
+        { &InputState::z,           ButtonShape::CIRCLE, 112, 24 },
+        { &InputState::midshield,   ButtonShape::CIRCLE, 122, 19 },
+        { &InputState::up,          ButtonShape::CIRCLE, 122, 29 },
+    };
+
+    constexpr DisplayButton right_squares[] = {
+        { &InputState::c_left,      ButtonShape::SQUARE, 79, 43 },
+        { &InputState::c_down,      ButtonShape::SQUARE, 79, 55 },
+        { &InputState::c_up,        ButtonShape::SQUARE, 87, 37 },
+        { &InputState::a,           ButtonShape::SQUARE, 87, 49 },
+        { &InputState::c_right,     ButtonShape::SQUARE, 95, 43 },
+        { &InputState::r,           ButtonShape::SQUARE, 90, 14 },
+        { &InputState::b,           ButtonShape::SQUARE, 90, 24 },
+        { &InputState::y,           ButtonShape::SQUARE, 100, 10 },
+        { &InputState::x,           ButtonShape::SQUARE, 99, 20 },
+        { &InputState::lightshield, ButtonShape::SQUARE, 110, 11 },
+        { &InputState::z,           ButtonShape::SQUARE, 109, 21 },
+        { &InputState::midshield,   ButtonShape::SQUARE, 119, 16 },
+        { &InputState::up,          ButtonShape::SQUARE, 119, 26 },
+    };
+
+    constexpr DisplayButton right_circles_19button[] = {
+        { &InputState::c_left,      ButtonShape::CIRCLE, 82, 46 },
+        { &InputState::c_down,      ButtonShape::CIRCLE, 82, 58 },
+        { &InputState::c_up,        ButtonShape::CIRCLE, 90, 40 },
+        { &InputState::a,           ButtonShape::CIRCLE, 90, 52 },
+        { &InputState::c_right,     ButtonShape::CIRCLE, 98, 46 },
+        { &InputState::r,           ButtonShape::CIRCLE, 93, 17 },
+        { &InputState::b,           ButtonShape::CIRCLE, 93, 27 },
+        { &InputState::y,           ButtonShape::CIRCLE, 103, 13 },
+        { &InputState::x,           ButtonShape::CIRCLE, 102, 23 },
+        { &InputState::lightshield, ButtonShape::CIRCLE, 113, 14 },
+        { &InputState::z,           ButtonShape::CIRCLE, 112, 24 },
+        { &InputState::up,          ButtonShape::CIRCLE, 122, 29 },
+    };
+
+    constexpr DisplayButton right_squares_19button[] = {
+        { &InputState::c_left,      ButtonShape::SQUARE, 79, 43 },
+        { &InputState::c_down,      ButtonShape::SQUARE, 79, 55 },
+        { &InputState::c_up,        ButtonShape::SQUARE, 87, 37 },
+        { &InputState::a,           ButtonShape::SQUARE, 87, 49 },
+        { &InputState::c_right,     ButtonShape::SQUARE, 95, 43 },
+        { &InputState::r,           ButtonShape::SQUARE, 90, 14 },
+        { &InputState::b,           ButtonShape::SQUARE, 90, 24 },
+        { &InputState::y,           ButtonShape::SQUARE, 100, 10 },
+        { &InputState::x,           ButtonShape::SQUARE, 99, 20 },
+        { &InputState::lightshield, ButtonShape::SQUARE, 110, 11 },
+        { &InputState::z,           ButtonShape::SQUARE, 109, 21 },
+        { &InputState::up,          ButtonShape::SQUARE, 119, 26 },
+    };
+
+    constexpr DisplayButton right_htangl[] = {
+        { &InputState::b,           ButtonShape::SQUARE, 89, 23 },
+        { &InputState::x,           ButtonShape::SQUARE, 99, 18 },
+        { &InputState::z,           ButtonShape::SQUARE, 109, 19 },
+        { &InputState::up,          ButtonShape::SQUARE, 119, 26 },
+        { &InputState::r,           ButtonShape::SQUARE, 89, 31 },
+        { &InputState::y,           ButtonShape::SQUARE, 99, 26 },
+        { &InputState::lightshield, ButtonShape::SQUARE, 109, 27 },
+        { &InputState::midshield,   ButtonShape::SQUARE, 119, 34 },
+        { &InputState::c_up,        ButtonShape::SQUARE, 88, 40 },
+        { &InputState::c_left,      ButtonShape::SQUARE, 80, 45 },
+        { &InputState::c_down,      ButtonShape::SQUARE, 80, 55 },
+        { &InputState::a,           ButtonShape::SQUARE, 88, 49 },
+        { &InputState::c_right,     ButtonShape::SQUARE, 96, 45 },
+    };
+
+    // Indexed by LeftLayout.
+    constexpr ButtonLayout left[] = {
+        { left_circles, sizeof(left_circles) / sizeof(DisplayButton) },
+        { left_squares, sizeof(left_squares) / sizeof(DisplayButton) },
+        { left_circles_wasd, sizeof(left_circles_wasd) / sizeof(DisplayButton) },
+        { left_squares_wasd, sizeof(left_squares_wasd) / sizeof(DisplayButton) },
+        { left_htangl, sizeof(left_htangl) / sizeof(DisplayButton) },
+    };
+
+    // Indexed by CenterLayout.
+    constexpr ButtonLayout center[] = {
+        { center_circles, sizeof(center_circles) / sizeof(DisplayButton) },
+        { center_circles_3button, sizeof(center_circles_3button) / sizeof(DisplayButton) },
+        { center_squares, sizeof(center_squares) / sizeof(DisplayButton) },
+        { center_squares_3button, sizeof(center_squares_3button) / sizeof(DisplayButton) },
+        { center_htangl, sizeof(center_htangl) / sizeof(DisplayButton) },
+    };
+
+    // Indexed by RightLayout.
+    constexpr ButtonLayout right[] = {
+        { right_circles, sizeof(right_circles) / sizeof(DisplayButton) },
+        { right_squares, sizeof(right_squares) / sizeof(DisplayButton) },
+        { right_circles_19button, sizeof(right_circles_19button) / sizeof(DisplayButton) },
+        { right_squares_19button, sizeof(right_squares_19button) / sizeof(DisplayButton) },
+        { right_htangl, sizeof(right_htangl) / sizeof(DisplayButton) },
+    };
+
+    constexpr const ButtonLayout &get(LeftLayout layout) {
+        return left[(int)layout];
+    }
+
+    constexpr const ButtonLayout &get(CenterLayout layout) {
+        return center[(int)layout];
+    }
+
+    constexpr const ButtonLayout &get(RightLayout layout) {
+        return right[(int)layout];
+    }
+}
+
+#endif
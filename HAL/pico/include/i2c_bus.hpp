@@ -0,0 +1,30 @@
+#ifndef _I2C_BUS_HPP
+#define _I2C_BUS_HPP
+
+#include "stdlib.hpp"
+
+#include <hardware/i2c.h>
+
+/*
+ * Lets devices on the same hardware I2C block, such as the Nunchuk and an OLED display, take turns
+ * using it from one core without blocking. Each device only starts a transfer once the block is
+ * idle, and points the block at its own target address first.
+ */
+namespace i2c_bus {
+    // Registers the DMA channel that feeds the block's data/command register, so that idle() also
+    // waits for the bytes it hasn't written yet. A channel of -1 removes it again.
+    void attach_dma(i2c_inst_t *i2c, int channel);
+
+    /**
+     * True once everything queued on the block has been sent and everything received has been read
+     * out. An abort that hasn't been cleared also keeps the block busy, because the controller
+     * discards everything written to it until the device whose transfer failed has cleared it.
+     */
+    bool idle(i2c_inst_t *i2c);
+
+    // Points the block at the given target address. The block has to be disabled to change it,
+    // which would throw away a transfer in progress, so this must only be called while idle.
+    void set_target(i2c_inst_t *i2c, uint16_t address);
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef _INPUT_ANALOGINPUT_HPP
+#define _INPUT_ANALOGINPUT_HPP
+
+#include "core/InputSource.hpp"
+#include "core/analog.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+// Number of samples per channel that are averaged.
+#define ANALOG_SAMPLES_PER_CHANNEL 8
+
+typedef struct {
+    uint8_t InputState::*value;
+    uint pin; // One of the ADC pins, 26-29
+    analog::ChannelCalibration calibration;
+} AnalogChannelMapping;
+
+/**
+ * Reads analog sensors such as Hall-effect triggers connected to the RP2040's ADC pins. The ADC
+ * samples all channels round-robin as fast as it can, and DMA copies the samples into a buffer
+ * without any CPU involvement. Updating inputs only averages the latest samples of each channel,
+ * so no time is spent waiting on conversions.
+ *
+ * If any mapping's pin isn't one of the ADC pins, the input source is disabled and never updates
+ * its inputs.
+ */
+class AnalogInput : public InputSource {
+  public:
+    AnalogInput(AnalogChannelMapping *channel_mappings, size_t channel_count);
+    ~AnalogInput();
+    InputScanSpeed ScanSpeed();
+    void UpdateInputs(InputState &inputs);
+
+  protected:
+    AnalogChannelMapping *_channel_mappings;
+    size_t _channel_count;
+
+    // Number of enabled ADC inputs, and index of each mapping's input within a round of samples.
+    size_t _round_size;
+    uint8_t *_sample_slots;
+    volatile uint16_t *_samples;
+    // Read by the control DMA channel to reset the sample channel's write address.
+    volatile uint16_t *_samples_start;
+
+    int _sample_dma = -1;
+    int _control_dma = -1;
+};
+
+#endif
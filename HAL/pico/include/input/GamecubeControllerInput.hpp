@@ -7,6 +7,18 @@
 #include <GamecubeController.hpp>
 #include <gamecube_definitions.h>
 
+#ifndef ANALOG_INPUT_STATE
+#error "GamecubeControllerInput needs the analog and gcc_ fields of InputState"
+#endif
+
+/**
+ * Passes through a real GameCube controller. Its control stick is reported as the Nunchuk stick,
+ * and everything is also reported in the analog and gcc_ fields of the input state.
+ *
+ * The controller is only polled once its polling interval has elapsed, and the last report received
+ * is published in between, so scanning this input source never waits on the controller. If a poll
+ * isn't answered, everything this input source reports goes back to rest until one is again.
+ */
 class GamecubeControllerInput : public InputSource {
   public:
     GamecubeControllerInput(
@@ -24,6 +36,11 @@ class GamecubeControllerInput : public InputSource {
   protected:
     GamecubeController *_controller;
     gc_report_t _report;
+    bool _connected = false;
+    uint32_t _poll_interval_us;
+    absolute_time_t _next_poll;
+
+    void ClearInputs(InputState &inputs);
 };
 
 #endif
\ No newline at end of file
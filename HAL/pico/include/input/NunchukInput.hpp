@@ -2,10 +2,28 @@
 #define _INPUT_NUNCHUKINPUT_HPP
 
 #include "core/InputSource.hpp"
+#include "core/StickCalibration.hpp"
+#include "core/state.hpp"
 
 #include <ArduinoNunchuk.hpp>
 #include <Wire.h>
+#include <hardware/i2c.h>
 
+#define NUNCHUK_I2C_ADDR 0x52
+#define NUNCHUK_REPORT_SIZE 6
+
+/**
+ * Reads a Wii Nunchuk over I2C without blocking. The connection handshake is done by
+ * ArduinoNunchuk in the constructor, but after that each UpdateInputs() call only advances the
+ * I2C transaction by one step using the I2C block's hardware FIFOs, and returns immediately. The
+ * decoded stick and buttons are published to the input state when a report has been fully read.
+ *
+ * If a stick calibration has been saved, it is applied to the stick before publishing. Holding C
+ * and Z while the Nunchuk is connected starts a new calibration: leave the stick centered, rotate
+ * it around the edges a few times, then press C and Z together again to save it. The calibration
+ * is used and written to flash straight away. The write stalls both cores, so a few polls are
+ * missed while it happens.
+ */
 class NunchukInput : public InputSource {
   public:
     NunchukInput(TwoWire &wire = Wire, int detect_pin = -1, int sda_pin = 4, int scl_pin = 5);
@@ -13,8 +31,30 @@ class NunchukInput : public InputSource {
     InputScanSpeed ScanSpeed();
     void UpdateInputs(InputState &inputs);
 
+    // Decodes a raw 6 byte Nunchuk report into the input state.
+    static void DecodeReport(const uint8_t *report, InputState &inputs);
+
+    // The I2C block behind a Wire instance. An I2C display can share it, because each waits for the
+    // other's transfer to finish and sets its own target address before starting one.
+    static i2c_inst_t *I2cBlock(TwoWire &wire);
+
   protected:
+    enum class TransferState {
+        IDLE,
+        READING,
+        REQUESTING,
+    };
+
     ArduinoNunchuk *_nunchuk;
+    StickCalibration *_calibration = nullptr;
+    bool _calibrated = false;
+    bool _capture_released = false;
+    i2c_inst_t *_i2c = nullptr;
+    TransferState _state = TransferState::IDLE;
+    uint32_t _request_sent_us = 0;
+
+    bool CheckAbort();
+    void UpdateCalibration(InputState &inputs, bool c, bool z);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,6 +1,9 @@
 #ifndef _JOYBUS_UTILS_HPP
 #define _JOYBUS_UTILS_HPP
 
+#include <GamecubeConsole.hpp>
+#include <N64Console.hpp>
+#include <hardware/pio.h>
 #include <stdlib.hpp>
 
 enum class ConnectedConsole {
@@ -9,6 +12,29 @@ enum class ConnectedConsole {
     NONE,
 };
 
+/**
+ * Detects which console (if any) is connected. Detection only runs once, so subsequent calls
+ * return the cached result.
+ *
+ * The console detected on the previous boot is stored in flash and used to decide which console to
+ * probe for first. The console instance that detected the console is kept so that the backend can
+ * take it over using take_detected_gamecube()/take_detected_n64() instead of setting up its PIO
+ * state machine from scratch.
+ */
 ConnectedConsole detect_console(uint joybus_pin);
 
-#endif
\ No newline at end of file
+/**
+ * Fills in the order in which consoles should be probed for, given the console detected on the
+ * previous boot and whether VBUS is powered. Returns the number of consoles to probe for.
+ */
+size_t console_probe_order(ConnectedConsole hint, bool vbus_powered, ConnectedConsole order[2]);
+
+/**
+ * Hands over ownership of the console instance created by detect_console(), if it is compatible
+ * with the given parameters. Returns nullptr otherwise, in which case the caller must create its
+ * own instance.
+ */
+GamecubeConsole *take_detected_gamecube(uint joybus_pin, PIO pio, int sm, int offset);
+N64Console *take_detected_n64(uint joybus_pin, PIO pio, int sm, int offset);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _PERSISTENT_STORAGE_HPP
+#define _PERSISTENT_STORAGE_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Emulated EEPROM layout. Each record starts with a magic byte that marks it as valid.
+ */
+#define STORAGE_CONSOLE_HINT_ADDR 0
+#define STORAGE_NUNCHUK_CALIBRATION_ADDR 16
+#define STORAGE_CUSTOM_LAYOUT_ADDR 32
+
+// Number of different records that can be staged at once.
+#define STORAGE_MAX_STAGED 3
+
+namespace persistent_storage {
+    /**
+     * Reads a record into data. Returns false, leaving data untouched, if no valid record is
+     * stored. Safe to call from both cores.
+     */
+    bool read(uint addr, uint8_t magic, void *data, size_t size);
+
+    /**
+     * Writes a record, unless an identical one is already stored, because writing stalls both
+     * cores while the flash sector is erased. Safe to call from both cores.
+     */
+    void write(uint addr, uint8_t magic, const void *data, size_t size);
+
+    /**
+     * Keeps a record in RAM until commit_staged(), replacing any record already staged at the same
+     * address. Code that runs while a backend is answering polls stages records instead of writing
+     * them, so the flash is only written when the caller knows the stall won't be noticed. Staged
+     * records are lost if the power is cut first. Returns false if too many records are staged.
+     * Safe to call from both cores.
+     */
+    bool stage(uint addr, uint8_t magic, const void *data, size_t size);
+
+    // True if there are staged records that haven't been written yet.
+    bool staged();
+
+    // Writes all staged records with a single flash commit. Safe to call from both cores.
+    void commit_staged();
+}
+
+#endif
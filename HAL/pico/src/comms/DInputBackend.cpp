@@ -10,9 +10,8 @@ DInputBackend::DInputBackend(InputSource **input_sources, size_t input_source_co
     _gamepad = new TUGamepad();
     _gamepad->begin();
 
-    while (!USBDevice.mounted()) {
-        delay(1);
-    }
+    // Don't wait for enumeration here so the rest of setup() can carry on in the meantime. This
+    // only moves the wait: the first SendReport() still spins until the host is ready.
 }
 
 DInputBackend::~DInputBackend() {
@@ -27,6 +26,7 @@ void DInputBackend::SendReport() {
     while (!_gamepad->ready()) {
         tight_loop_contents();
     }
+    _poll_stats.PollStarted();
 
     ScanInputs(InputScanSpeed::FAST);
 
@@ -58,5 +58,9 @@ void DInputBackend::SendReport() {
     // D-pad Hat Switch
     _gamepad->hatSwitch(_outputs.dpadLeft, _outputs.dpadRight, _outputs.dpadDown, _outputs.dpadUp);
 
-    _gamepad->sendState();
+    if (_gamepad->sendState()) {
+        _poll_stats.ReplySent();
+    } else {
+        _poll_stats.PollSkipped();
+    }
 }
@@ -1,6 +1,8 @@
 #include "comms/GamecubeBackend.hpp"
 
+#include "comms/PioJoybusLink.hpp"
 #include "core/InputSource.hpp"
+#include "joybus_utils.hpp"
 
 #include <GamecubeConsole.hpp>
 #include <hardware/pio.h>
@@ -15,8 +17,27 @@ GamecubeBackend::GamecubeBackend(
     int offset
 )
     : CommunicationBackend(input_sources, input_source_count) {
-    _gamecube = new GamecubeConsole(data_pin, pio, sm, offset);
-    _report = default_gc_report;
+    // Take over the instance used for console detection if possible, so that the PIO program and
+    // state machine don't have to be torn down and set up again.
+    GamecubeConsole *gamecube = take_detected_gamecube(data_pin, pio, sm, offset);
+    if (gamecube == nullptr) {
+        gamecube = new GamecubeConsole(data_pin, pio, sm, offset);
+    }
+    _gamecube = new PioGamecubeLink(gamecube);
+    _reports[0] = default_gc_report;
+    _reports[1] = default_gc_report;
+}
+
+GamecubeBackend::GamecubeBackend(
+    InputSource **input_sources,
+    size_t input_source_count,
+    GamecubeLink *link
+)
+    : CommunicationBackend(input_sources, input_source_count) {
+    // Takes ownership of a link created elsewhere, e.g. a stand-in console.
+    _gamecube = link;
+    _reports[0] = default_gc_report;
+    _reports[1] = default_gc_report;
 }
 
 GamecubeBackend::~GamecubeBackend() {
@@ -30,6 +51,7 @@ void GamecubeBackend::SendReport() {
 
     // Read inputs
     _gamecube->WaitForPollStart();
+    _poll_stats.PollStarted();
 
     // Update fast inputs in response to poll.
     // But wait 40us first so that we read inputs at the start of the 3rd byte of the poll command
@@ -40,34 +62,52 @@ void GamecubeBackend::SendReport() {
     // Run gamemode logic.
     UpdateOutputs();
 
+    // Build the report in the buffer that isn't currently published.
+    gc_report_t &report = _reports[_published ^ 1];
+
     // Digital outputs
-    _report.a = _outputs.a;
-    _report.b = _outputs.b;
-    _report.x = _outputs.x;
-    _report.y = _outputs.y;
-    _report.z = _outputs.buttonR;
-    _report.l = _outputs.triggerLDigital;
-    _report.r = _outputs.triggerRDigital;
-    _report.start = _outputs.start;
-    _report.dpad_left = _outputs.dpadLeft | _outputs.select;
-    _report.dpad_right = _outputs.dpadRight | _outputs.home;
-    _report.dpad_down = _outputs.dpadDown;
-    _report.dpad_up = _outputs.dpadUp;
+    report.a = _outputs.a;
+    report.b = _outputs.b;
+    report.x = _outputs.x;
+    report.y = _outputs.y;
+    report.z = _outputs.buttonR;
+    report.l = _outputs.triggerLDigital;
+    report.r = _outputs.triggerRDigital;
+    report.start = _outputs.start;
+    report.dpad_left = _outputs.dpadLeft | _outputs.select;
+    report.dpad_right = _outputs.dpadRight | _outputs.home;
+    report.dpad_down = _outputs.dpadDown;
+    report.dpad_up = _outputs.dpadUp;
 
     // Analog outputs
-    _report.stick_x = _outputs.leftStickX;
-    _report.stick_y = _outputs.leftStickY;
-    _report.cstick_x = _outputs.rightStickX;
-    _report.cstick_y = _outputs.rightStickY;
-    _report.l_analog = _outputs.triggerLAnalog;
-    _report.r_analog = _outputs.triggerRAnalog;
-
-    // Send outputs to console unless poll command is invalid.
-    if (_gamecube->WaitForPollEnd() != PollStatus::ERROR) {
-        _gamecube->SendReport(&_report);
+    report.stick_x = _outputs.leftStickX;
+    report.stick_y = _outputs.leftStickY;
+    report.cstick_x = _outputs.rightStickX;
+    report.cstick_y = _outputs.rightStickY;
+    report.l_analog = _outputs.triggerLAnalog;
+    report.r_analog = _outputs.triggerRAnalog;
+    _poll_stats.ReportReady();
+
+    // Send outputs to console unless poll command is invalid. The rumble bit is only meaningful
+    // if the poll was valid, so leave the last known state alone otherwise.
+    PollStatus status = _gamecube->WaitForPollEnd();
+    if (status != PollStatus::ERROR) {
+        _gamecube->SendReport(&report);
+        _poll_stats.ReplySent();
+        _feedback.rumble = status == PollStatus::RUMBLE_ON;
+
+        // Make sure the report is fully written before the other core can see it.
+        __sync_synchronize();
+        _published ^= 1;
+    } else {
+        _poll_stats.PollSkipped();
     }
 }
 
 int GamecubeBackend::GetOffset() {
     return _gamecube->GetOffset();
 }
+
+void GamecubeBackend::GetLastReport(gc_report_t &report) {
+    report = _reports[_published];
+}
@@ -0,0 +1,45 @@
+#include "comms/GamecubeMirrorBackend.hpp"
+
+#include "comms/GamecubeBackend.hpp"
+#include "comms/PioJoybusLink.hpp"
+
+#include <GamecubeConsole.hpp>
+#include <hardware/pio.h>
+
+GamecubeMirrorBackend::GamecubeMirrorBackend(
+    GamecubeBackend *source,
+    uint data_pin,
+    PIO pio,
+    int sm,
+    int offset
+)
+    : CommunicationBackend(nullptr, 0) {
+    _source = source;
+    _gamecube = new PioGamecubeLink(new GamecubeConsole(data_pin, pio, sm, offset));
+    _report = default_gc_report;
+}
+
+GamecubeMirrorBackend::GamecubeMirrorBackend(GamecubeBackend *source, GamecubeLink *link)
+    : CommunicationBackend(nullptr, 0) {
+    // Takes ownership of a link created elsewhere, e.g. a stand-in console.
+    _source = source;
+    _gamecube = link;
+    _report = default_gc_report;
+}
+
+GamecubeMirrorBackend::~GamecubeMirrorBackend() {
+    delete _gamecube;
+}
+
+void GamecubeMirrorBackend::SendReport() {
+    _gamecube->WaitForPollStart();
+
+    // Copy the latest report sent on the primary port while the rest of the poll comes in.
+    _source->GetLastReport(_report);
+
+    PollStatus status = _gamecube->WaitForPollEnd();
+    if (status != PollStatus::ERROR) {
+        _gamecube->SendReport(&_report);
+        _feedback.rumble = status == PollStatus::RUMBLE_ON;
+    }
+}
@@ -1,6 +1,8 @@
 #include "comms/N64Backend.hpp"
 
+#include "comms/PioJoybusLink.hpp"
 #include "core/InputSource.hpp"
+#include "joybus_utils.hpp"
 
 #include <N64Console.hpp>
 #include <hardware/pio.h>
@@ -14,7 +16,20 @@ N64Backend::N64Backend(
     int offset
 )
     : CommunicationBackend(input_sources, input_source_count) {
-    _n64 = new N64Console(data_pin, pio, sm, offset);
+    // Take over the instance used for console detection if possible, so that the PIO program and
+    // state machine don't have to be torn down and set up again.
+    N64Console *n64 = take_detected_n64(data_pin, pio, sm, offset);
+    if (n64 == nullptr) {
+        n64 = new N64Console(data_pin, pio, sm, offset);
+    }
+    _n64 = new PioN64Link(n64);
+    _report = default_n64_report;
+}
+
+N64Backend::N64Backend(InputSource **input_sources, size_t input_source_count, N64Link *link)
+    : CommunicationBackend(input_sources, input_source_count) {
+    // Takes ownership of a link created elsewhere, e.g. a stand-in console.
+    _n64 = link;
     _report = default_n64_report;
 }
 
@@ -22,6 +37,21 @@ N64Backend::~N64Backend() {
     delete _n64;
 }
 
+void N64Backend::SetGameMode(ControllerMode *gamemode) {
+    // Build the mode's N64 coordinate map now so that polls only need a table lookup.
+    if (gamemode != nullptr) {
+        gamemode->InitN64AxisMap(_stick_range);
+    }
+    CommunicationBackend::SetGameMode(gamemode);
+}
+
+void N64Backend::SetStickRange(uint8_t range) {
+    _stick_range = range;
+    if (_gamemode != nullptr) {
+        _gamemode->InitN64AxisMap(_stick_range);
+    }
+}
+
 void N64Backend::SendReport() {
     // Update slower inputs before we start waiting for poll.
     ScanInputs(InputScanSpeed::SLOW);
@@ -29,6 +59,7 @@ void N64Backend::SendReport() {
 
     // Read inputs
     _n64->WaitForPoll();
+    _poll_stats.PollStarted();
 
     // Update fast inputs in response to poll.
     ScanInputs(InputScanSpeed::FAST);
@@ -53,12 +84,18 @@ void N64Backend::SendReport() {
     _report.c_down = _outputs.rightStickY < 128;
     _report.c_up = _outputs.rightStickY > 128;
 
-    // Analog outputs
-    _report.stick_x = _outputs.leftStickX - 128;
-    _report.stick_y = _outputs.leftStickY - 128;
+    // Analog outputs - converted to N64 coordinates using the mode's precomputed map
+    if (_gamemode != nullptr) {
+        _report.stick_x = _gamemode->N64AxisX(_outputs.leftStickX);
+        _report.stick_y = _gamemode->N64AxisY(_outputs.leftStickY);
+    } else {
+        _report.stick_x = _outputs.leftStickX - 128;
+        _report.stick_y = _outputs.leftStickY - 128;
+    }
 
     // Send outputs to console.
     _n64->SendReport(&_report);
+    _poll_stats.ReplySent();
 }
 
 int N64Backend::GetOffset() {
@@ -106,6 +106,7 @@ void NintendoSwitchBackend::SendReport() {
     while (!TUCompositeHID::_usb_hid.ready()) {
         tight_loop_contents();
     }
+    _poll_stats.PollStarted();
 
     ScanInputs(InputScanSpeed::FAST);
 
@@ -136,7 +137,13 @@ void NintendoSwitchBackend::SendReport() {
     _report.hat =
         GetHatPosition(_outputs.dpadLeft, _outputs.dpadRight, _outputs.dpadDown, _outputs.dpadUp);
 
-    TUCompositeHID::_usb_hid.sendReport(_report_id, &_report, sizeof(switch_gamepad_report_t));
+    bool sent =
+        TUCompositeHID::_usb_hid.sendReport(_report_id, &_report, sizeof(switch_gamepad_report_t));
+    if (sent) {
+        _poll_stats.ReplySent();
+    } else {
+        _poll_stats.PollSkipped();
+    }
 }
 
 switch_gamepad_hat_t NintendoSwitchBackend::GetHatPosition(
@@ -0,0 +1,48 @@
+#include "comms/PioJoybusLink.hpp"
+
+#include <GamecubeConsole.hpp>
+#include <N64Console.hpp>
+
+PioGamecubeLink::PioGamecubeLink(GamecubeConsole *gamecube) {
+    _gamecube = gamecube;
+}
+
+PioGamecubeLink::~PioGamecubeLink() {
+    delete _gamecube;
+}
+
+void PioGamecubeLink::WaitForPollStart() {
+    _gamecube->WaitForPollStart();
+}
+
+PollStatus PioGamecubeLink::WaitForPollEnd() {
+    return _gamecube->WaitForPollEnd();
+}
+
+void PioGamecubeLink::SendReport(gc_report_t *report) {
+    _gamecube->SendReport(report);
+}
+
+int PioGamecubeLink::GetOffset() {
+    return _gamecube->GetOffset();
+}
+
+PioN64Link::PioN64Link(N64Console *n64) {
+    _n64 = n64;
+}
+
+PioN64Link::~PioN64Link() {
+    delete _n64;
+}
+
+void PioN64Link::WaitForPoll() {
+    _n64->WaitForPoll();
+}
+
+void PioN64Link::SendReport(n64_report_t *report) {
+    _n64->SendReport(report);
+}
+
+int PioN64Link::GetOffset() {
+    return _n64->GetOffset();
+}
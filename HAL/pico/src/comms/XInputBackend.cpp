@@ -14,9 +14,8 @@ XInputBackend::XInputBackend(InputSource **input_sources, size_t input_source_co
 
     TinyUSBDevice.setID(0x0738, 0x4726);
 
-    while (!_xinput->ready()) {
-        delay(1);
-    }
+    // Don't wait for enumeration here so the rest of setup() can carry on in the meantime. This
+    // only moves the wait: the first SendReport() still spins until the host is ready.
 }
 
 XInputBackend::~XInputBackend() {
@@ -30,6 +29,7 @@ void XInputBackend::SendReport() {
     while (!_xinput->ready()) {
         tight_loop_contents();
     }
+    _poll_stats.PollStarted();
 
     ScanInputs(InputScanSpeed::FAST);
 
@@ -59,5 +59,9 @@ void XInputBackend::SendReport() {
     _report.rx = (_outputs.rightStickX - 128) * 65535 / 255 + 128;
     _report.ry = (_outputs.rightStickY - 128) * 65535 / 255 + 128;
 
-    _xinput->sendReport(&_report);
+    if (_xinput->sendReport(&_report)) {
+        _poll_stats.ReplySent();
+    } else {
+        _poll_stats.PollSkipped();
+    }
 }
\ No newline at end of file
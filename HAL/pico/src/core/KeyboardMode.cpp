@@ -10,14 +10,16 @@ KeyboardMode::KeyboardMode() {
 }
 
 KeyboardMode::~KeyboardMode() {
+    // Make sure the host sees all keys released before the keyboard goes away.
     _keyboard->releaseAll();
-    _keyboard->sendState();
+    _keyboard->flush();
     delete _keyboard;
 }
 
 void KeyboardMode::SendReport(InputState &inputs) {
     HandleSocd(inputs);
     UpdateKeys(inputs);
+    // Doesn't block if the endpoint is busy, so the next controller poll is never delayed.
     _keyboard->sendState();
 }
 
@@ -0,0 +1,246 @@
+#include "display/DisplayDma.hpp"
+
+#include "i2c_bus.hpp"
+
+#include <hardware/dma.h>
+#include <hardware/gpio.h>
+#include <hardware/i2c.h>
+#include <hardware/irq.h>
+#include <hardware/spi.h>
+#include <lib/OneBitDisplay/OneBitDisplay.h>
+
+#define OLED_COMMAND 0x00
+#define OLED_DATA 0x40
+
+DisplayDma *DisplayDma::_spi_instance = nullptr;
+
+DisplayDma::DisplayDma(OBDISP *obd) {
+    // The SH1106 has 132 columns of memory with the visible 128 in the middle.
+    _column_offset = obd->type == OLED_132x64 ? 2 : 0;
+    _channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(_channel);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+
+    if (obd->com_mode == COM_SPI) {
+        _spi = obd->bbi2c.picoSPI;
+        _cs_pin = obd->iCSPin;
+        _dc_pin = obd->iDCPin;
+
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+        channel_config_set_dreq(&config, spi_get_dreq(_spi, true));
+        dma_channel_configure(_channel, &config, &spi_get_hw(_spi)->dr, _buffer, 0, false);
+
+        // Every byte sent is also received, and reading them all back keeps the receive FIFO from
+        // overflowing.
+        _rx_channel = dma_claim_unused_channel(true);
+        dma_channel_config rx_config = dma_channel_get_default_config(_rx_channel);
+        channel_config_set_transfer_data_size(&rx_config, DMA_SIZE_8);
+        channel_config_set_read_increment(&rx_config, false);
+        channel_config_set_write_increment(&rx_config, false);
+        channel_config_set_dreq(&rx_config, spi_get_dreq(_spi, false));
+        dma_channel_configure(
+            _rx_channel,
+            &rx_config,
+            &_rx_discard,
+            &spi_get_hw(_spi)->dr,
+            0,
+            false
+        );
+
+        // Transfers are chained from the receive channel's completion interrupt. It is enabled on
+        // the core that creates this, which is the core that does the drawing.
+        _spi_instance = this;
+        irq_add_shared_handler(
+            DMA_IRQ_1,
+            HandleSpiIrq,
+            PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY
+        );
+        dma_channel_set_irq1_enabled(_rx_channel, true);
+        irq_set_enabled(DMA_IRQ_1, true);
+        return;
+    }
+
+    _i2c = obd->bbi2c.picoI2C;
+    _address = obd->oled_addr;
+
+    // Only the low 11 bits of the data/command register are used, and 16 bit writes to peripheral
+    // registers are replicated across the whole register, so the buffer can be half the size.
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_dreq(&config, i2c_get_dreq(_i2c, true));
+    dma_channel_configure(_channel, &config, &_i2c->hw->data_cmd, _buffer, 0, false);
+    i2c_bus::attach_dma(_i2c, _channel);
+}
+
+DisplayDma::~DisplayDma() {
+    if (_spi != nullptr) {
+        dma_channel_set_irq1_enabled(_rx_channel, false);
+        irq_remove_handler(DMA_IRQ_1, HandleSpiIrq);
+        _spi_instance = nullptr;
+        dma_channel_abort(_rx_channel);
+        dma_channel_unclaim(_rx_channel);
+    } else {
+        i2c_bus::attach_dma(_i2c, -1);
+    }
+    dma_channel_abort(_channel);
+    dma_channel_unclaim(_channel);
+}
+
+bool DisplayDma::Supports(OBDISP *obd) {
+    if (obd->com_mode == COM_I2C) {
+        if (obd->bbi2c.picoI2C == nullptr) {
+            return false;
+        }
+    } else if (obd->com_mode == COM_SPI) {
+        // OneBitDisplay marks hardware SPI by setting the MOSI pin to 0xFF, and a D/C pin is
+        // needed to tell commands from data.
+        if (obd->bbi2c.picoSPI == nullptr || obd->iMOSIPin != 0xFF || obd->iDCPin == 0xFF) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    // Other panel types need their positions translated in ways that aren't handled here.
+    return obd->type == OLED_128x32 || obd->type == OLED_128x64 || obd->type == OLED_132x64;
+}
+
+bool DisplayDma::Busy() {
+    if (_spi != nullptr) {
+        return _spi_busy;
+    }
+    // A transfer that had to wait for another device on the bus is started once the bus is free.
+    if (_length > 0) {
+        Start();
+        return true;
+    }
+    // The DMA channel finishes as soon as the last byte is in the FIFO, so also wait for the
+    // controller to send it.
+    return dma_channel_is_busy(_channel) || _i2c->hw->txflr > 0 ||
+           (_i2c->hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+bool DisplayDma::Aborted() {
+    if (_spi != nullptr) {
+        return false;
+    }
+    // The block stays pointed at whichever device's transfer failed, and an abort during another
+    // device's transfer is left for that device to clear.
+    if (_i2c->hw->tar != _address ||
+        !(_i2c->hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+        return false;
+    }
+    // The controller discards everything written to it until the abort is cleared.
+    (void)_i2c->hw->clr_tx_abrt;
+    return true;
+}
+
+bool DisplayDma::AddRun(int x, int page, const uint8_t *data, int length) {
+    x += _column_offset;
+    if (_spi != nullptr) {
+        return AddSpiRun(x, page, data, length);
+    }
+    return AddI2cRun(x, page, data, length);
+}
+
+bool DisplayDma::AddI2cRun(int x, int page, const uint8_t *data, int length) {
+    if (_length + length + 5 > DISPLAY_DMA_BUFFER_SIZE) {
+        return false;
+    }
+
+    uint16_t *out = &_buffer[_length];
+    *out++ = OLED_COMMAND;
+    *out++ = 0xB0 | page;
+    *out++ = x & 0x0F;
+    *out++ = (0x10 | (x >> 4)) | I2C_IC_DATA_CMD_STOP_BITS;
+    *out++ = OLED_DATA;
+    for (int i = 0; i < length; i++) {
+        *out++ = data[i];
+    }
+    out[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    _length += length + 5;
+    return true;
+}
+
+bool DisplayDma::AddSpiRun(int x, int page, const uint8_t *data, int length) {
+    if (_run_count >= DISPLAY_DMA_MAX_RUNS || _length + length > sizeof(_buffer)) {
+        return false;
+    }
+
+    Run &run = _runs[_run_count++];
+    run.command[0] = 0xB0 | page;
+    run.command[1] = 0x10 | (x >> 4);
+    run.command[2] = x & 0x0F;
+    run.offset = _length;
+    run.length = length;
+    memcpy((uint8_t *)_buffer + _length, data, length);
+
+    _length += length;
+    return true;
+}
+
+void DisplayDma::Start() {
+    if (_length == 0) {
+        return;
+    }
+
+    if (_spi == nullptr) {
+        // Another device on the same block, i.e. the Nunchuk, may be in the middle of a transfer.
+        if (!i2c_bus::idle(_i2c)) {
+            return;
+        }
+        i2c_bus::set_target(_i2c, _address);
+        dma_channel_transfer_from_buffer_now(_channel, _buffer, _length);
+        _length = 0;
+        return;
+    }
+
+    _spi_busy = true;
+    _next_run = 0;
+    gpio_put(_cs_pin, 0);
+    StartSpiRun();
+}
+
+void DisplayDma::SendSpi(const uint8_t *data, size_t length) {
+    // The receive channel is started first, so it is ready for the first byte sent.
+    dma_channel_set_trans_count(_rx_channel, length, true);
+    dma_channel_transfer_from_buffer_now(_channel, data, length);
+}
+
+void DisplayDma::StartSpiRun() {
+    // Only called once everything sent before has been shifted out, so D/C can change.
+    if (_next_run == _run_count) {
+        gpio_put(_cs_pin, 1);
+        _run_count = 0;
+        _length = 0;
+        _spi_busy = false;
+        return;
+    }
+
+    const Run &run = _runs[_next_run];
+    gpio_put(_dc_pin, 0);
+    _sending_command = true;
+    SendSpi(run.command, sizeof(run.command));
+}
+
+void DisplayDma::StartSpiData() {
+    const Run &run = _runs[_next_run];
+    _next_run = _next_run + 1;
+    gpio_put(_dc_pin, 1);
+    _sending_command = false;
+    SendSpi((uint8_t *)_buffer + run.offset, run.length);
+}
+
+void DisplayDma::HandleSpiIrq() {
+    DisplayDma *instance = _spi_instance;
+    // The interrupt is shared, so it may be for another channel.
+    if (instance == nullptr || !dma_channel_get_irq1_status(instance->_rx_channel)) {
+        return;
+    }
+    dma_channel_acknowledge_irq1(instance->_rx_channel);
+    if (instance->_sending_command) {
+        instance->StartSpiData();
+    } else {
+        instance->StartSpiRun();
+    }
+}
@@ -0,0 +1,52 @@
+#include "display/FrameScheduler.hpp"
+
+FrameScheduler::FrameScheduler(uint32_t frame_rate) {
+    _period_us = 1000000 / frame_rate;
+}
+
+bool FrameScheduler::FrameDue(uint32_t now_us) {
+    if (!_started) {
+        _next_frame_us = now_us;
+        _started = true;
+    }
+
+    // Compared as a difference so that the microsecond counter wrapping around doesn't matter.
+    int32_t late_us = (int32_t)(now_us - _next_frame_us);
+    if (late_us < 0) {
+        return false;
+    }
+
+    uint32_t missed = (uint32_t)late_us / _period_us;
+    _frames_skipped += missed;
+    _next_frame_us += (missed + 1) * _period_us;
+    _frame_start_us = now_us;
+    return true;
+}
+
+void FrameScheduler::FrameDone(uint32_t now_us) {
+    _frame_time_us = now_us - _frame_start_us;
+    if (_frame_time_us > _max_frame_time_us) {
+        _max_frame_time_us = _frame_time_us;
+    }
+    _frames_drawn++;
+}
+
+void FrameScheduler::SkipFrame() {
+    _frames_skipped++;
+}
+
+uint32_t FrameScheduler::FramesDrawn() {
+    return _frames_drawn;
+}
+
+uint32_t FrameScheduler::FramesSkipped() {
+    return _frames_skipped;
+}
+
+uint32_t FrameScheduler::FrameTime() {
+    return _frame_time_us;
+}
+
+uint32_t FrameScheduler::MaxFrameTime() {
+    return _max_frame_time_us;
+}
@@ -0,0 +1,300 @@
+#include "display/InputDisplay.hpp"
+
+#include "core/state.hpp"
+#include "display/DisplayDma.hpp"
+#include "i2c_bus.hpp"
+
+#include <cstring>
+#include <lib/OneBitDisplay/OneBitDisplay.h>
+
+#define FONT_WIDTH 6
+#define BUTTON_RADIUS 4
+#define BUTTON_SIZE 6
+
+InputDisplay::InputDisplay(OBDISP *obd) {
+    _obd = obd;
+    if (DisplayDma::Supports(obd)) {
+        _dma = new DisplayDma(obd);
+    }
+    RasterizeSprites();
+}
+
+void InputDisplay::RasterizeSprites() {
+    // Draw each sprite on a small off-screen display, then read it back column by column.
+    uint8_t buffer[INPUT_DISPLAY_SPRITE_SIZE * 2 * 2];
+    OBDISP canvas;
+    obdCreateVirtualDisplay(&canvas, INPUT_DISPLAY_SPRITE_SIZE, 16, buffer);
+
+    for (int shape = 0; shape < (int)ButtonShape::SHAPE_COUNT; shape++) {
+        for (int pressed = 0; pressed < 2; pressed++) {
+            memset(buffer, 0, sizeof(buffer));
+            if ((ButtonShape)shape == ButtonShape::CIRCLE) {
+                obdPreciseEllipse(
+                    &canvas,
+                    BUTTON_RADIUS,
+                    BUTTON_RADIUS,
+                    BUTTON_RADIUS,
+                    BUTTON_RADIUS,
+                    1,
+                    pressed
+                );
+            } else {
+                obdRectangle(&canvas, 0, 0, BUTTON_SIZE, BUTTON_SIZE, 1, pressed);
+            }
+
+            for (int x = 0; x < INPUT_DISPLAY_SPRITE_SIZE; x++) {
+                _sprites[shape][pressed][x] =
+                    buffer[x] | (buffer[INPUT_DISPLAY_SPRITE_SIZE + x] << 8);
+            }
+        }
+    }
+}
+
+void InputDisplay::AddButtons(const DisplayButton *buttons, size_t button_count) {
+    for (size_t i = 0; i < button_count && _button_count < INPUT_DISPLAY_MAX_BUTTONS; i++) {
+        _buttons[_button_count] = &buttons[i];
+        _drawn[_button_count] = false;
+        _button_count++;
+    }
+}
+
+void InputDisplay::AddLayout(const ButtonLayout &layout) {
+    AddButtons(layout.buttons, layout.button_count);
+}
+
+void InputDisplay::SetLabel(DisplayLabel label, const char *text) {
+    if (_labels[label] == text) {
+        return;
+    }
+    _labels[label] = text;
+    RenderLabel(label);
+    _labels_dirty = true;
+}
+
+void InputDisplay::RenderLabel(DisplayLabel label) {
+    const char *text = _labels[label];
+    size_t length = text == nullptr ? 0 : strlen(text);
+    if (length > INPUT_DISPLAY_MAX_LABEL_WIDTH / FONT_WIDTH) {
+        length = INPUT_DISPLAY_MAX_LABEL_WIDTH / FONT_WIDTH;
+    }
+    _label_widths[label] = length * FONT_WIDTH;
+    if (length == 0) {
+        return;
+    }
+
+    // Render onto a single 8 pixel row, which is laid out exactly like one page of the screen.
+    OBDISP canvas = {};
+    obdCreateVirtualDisplay(&canvas, INPUT_DISPLAY_MAX_LABEL_WIDTH, 8, _label_columns[label]);
+    memset(_label_columns[label], 0, INPUT_DISPLAY_MAX_LABEL_WIDTH);
+    obdWriteString(&canvas, 0, 0, 0, (char *)text, FONT_6x8, 0, 0);
+}
+
+void InputDisplay::DrawText(int row, const char *text) {
+    // The top row belongs to the labels.
+    if (row < 1 || row >= _obd->height / 8) {
+        return;
+    }
+    int y = row * 8;
+    obdRectangle(_obd, 0, y, _obd->width - 1, y + 7, 0, 1);
+    obdWriteString(_obd, 0, 0, row, (char *)text, FONT_6x8, 0, 0);
+    MarkDirty(0, y, _obd->width - 1, y + 7);
+}
+
+void InputDisplay::DrawRect(int x1, int y1, int x2, int y2, bool color, bool fill) {
+    obdRectangle(_obd, x1, y1, x2, y2, color, fill);
+    MarkDirty(x1, y1, x2, y2);
+}
+
+void InputDisplay::Update(InputState &inputs) {
+    if (_labels_dirty) {
+        DrawLabels();
+        _labels_dirty = false;
+    }
+
+    for (size_t i = 0; i < _button_count; i++) {
+        bool pressed = inputs.*(_buttons[i]->input);
+        if (_drawn[i] && pressed == _drawn_pressed[i]) {
+            continue;
+        }
+        DrawButton(i, pressed, true);
+
+        // Erasing the button can clip the edges of buttons whose bounds overlap it, so draw those
+        // again over the top.
+        int x1, y1, x2, y2;
+        GetBounds(*_buttons[i], x1, y1, x2, y2);
+        for (size_t j = 0; j < _button_count; j++) {
+            int ox1, oy1, ox2, oy2;
+            GetBounds(*_buttons[j], ox1, oy1, ox2, oy2);
+            if (j != i && _drawn[j] && ox1 <= x2 && ox2 >= x1 && oy1 <= y2 && oy2 >= y1) {
+                DrawButton(j, _drawn_pressed[j], false);
+            }
+        }
+    }
+
+    Flush();
+}
+
+bool InputDisplay::Ready() {
+    if (_dma != nullptr) {
+        return !_dma->Busy();
+    }
+    // Without DMA the panel is written by blocking calls that set the target address themselves,
+    // so they must not start while the Nunchuk is using the same block.
+    if (_obd->com_mode == COM_I2C && _obd->bbi2c.picoI2C != nullptr) {
+        return i2c_bus::idle(_obd->bbi2c.picoI2C);
+    }
+    return true;
+}
+
+void InputDisplay::GetBounds(const DisplayButton &button, int &x1, int &y1, int &x2, int &y2) {
+    if (button.shape == ButtonShape::CIRCLE) {
+        x1 = button.x - BUTTON_RADIUS;
+        y1 = button.y - BUTTON_RADIUS;
+        x2 = button.x + BUTTON_RADIUS;
+        y2 = button.y + BUTTON_RADIUS;
+    } else {
+        x1 = button.x;
+        y1 = button.y;
+        x2 = button.x + BUTTON_SIZE;
+        y2 = button.y + BUTTON_SIZE;
+    }
+}
+
+void InputDisplay::DrawButton(size_t index, bool pressed, bool erase) {
+    const DisplayButton &button = *_buttons[index];
+    int x1, y1, x2, y2;
+    GetBounds(button, x1, y1, x2, y2);
+
+    // When erasing, the whole bounding box is overwritten. Otherwise only the sprite's lit pixels
+    // are drawn, so that neighbouring buttons aren't clipped.
+    Blit(_sprites[(int)button.shape][pressed], x1, y1, x2 - x1 + 1, y2 - y1 + 1, erase);
+
+    _drawn[index] = true;
+    _drawn_pressed[index] = pressed;
+    MarkDirty(x1, y1, x2, y2);
+}
+
+void InputDisplay::Blit(const uint16_t *columns, int x, int y, int width, int height, bool opaque) {
+    uint8_t *screen = _obd->ucScreen;
+    int pages = _obd->height / 8;
+    uint32_t area = (1 << height) - 1;
+
+    for (int col = 0; col < width; col++) {
+        int dest_x = x + col;
+        if (dest_x < 0 || dest_x >= _obd->width) {
+            continue;
+        }
+
+        uint32_t bits = columns[col];
+        uint32_t mask = opaque ? area : bits;
+        int page = y >> 3;
+        // Sprites are at most 9 rows tall, so they span at most 3 pages.
+        bits <<= y & 7;
+        mask <<= y & 7;
+        for (int i = 0; i < 3 && page + i < pages; i++, bits >>= 8, mask >>= 8) {
+            if (page + i < 0 || !(mask & 0xFF)) {
+                continue;
+            }
+            uint8_t &dest = screen[(page + i) * _obd->width + dest_x];
+            dest = (dest & ~mask) | (bits & mask);
+        }
+    }
+}
+
+void InputDisplay::DrawLabels() {
+    // Labels share the top row, so put all of them together again if any changed.
+    int width = _obd->width < INPUT_DISPLAY_MAX_LABEL_WIDTH ? _obd->width
+                                                              : INPUT_DISPLAY_MAX_LABEL_WIDTH;
+    uint8_t row[INPUT_DISPLAY_MAX_LABEL_WIDTH] = {};
+    for (size_t i = 0; i < LABEL_COUNT; i++) {
+        int text_width = _label_widths[i] < width ? _label_widths[i] : width;
+        int x = i == LABEL_LEFT     ? 0
+                : i == LABEL_CENTER ? (width - text_width) / 2
+                                    : width - text_width;
+        // Where labels overlap, later ones are drawn over earlier ones, same as writing them to
+        // the screen one after another.
+        for (int col = 0; col < text_width; col++) {
+            row[x + col] = _label_columns[i][col];
+        }
+    }
+
+    // Only the columns that differ from what is on the screen need to be sent.
+    uint8_t *screen = _obd->ucScreen;
+    for (int x = 0; x < width; x++) {
+        if (screen[x] != row[x]) {
+            screen[x] = row[x];
+            MarkDirty(x, 0, x, 7);
+        }
+    }
+}
+
+void InputDisplay::MarkDirty(int x1, int y1, int x2, int y2) {
+    x1 = x1 < 0 ? 0 : x1;
+    y1 = y1 < 0 ? 0 : y1;
+    x2 = x2 >= _obd->width ? _obd->width - 1 : x2;
+    y2 = y2 >= _obd->height ? _obd->height - 1 : y2;
+    if (x2 < x1 || y2 < y1) {
+        return;
+    }
+
+    uint8_t tiles = 0;
+    for (int tile = x1 / INPUT_DISPLAY_TILE_WIDTH; tile <= x2 / INPUT_DISPLAY_TILE_WIDTH; tile++) {
+        tiles |= 1 << tile;
+    }
+    for (int page = y1 / 8; page <= y2 / 8; page++) {
+        _dirty_tiles[page] |= tiles;
+    }
+}
+
+void InputDisplay::Flush() {
+    if (_dma != nullptr) {
+        // Leave the tiles marked until the previous transfer is done.
+        if (_dma->Busy()) {
+            return;
+        }
+        // Part of the last transfer never reached the panel, so send everything again.
+        if (_dma->Aborted()) {
+            MarkDirty(0, 0, _obd->width - 1, _obd->height - 1);
+        }
+    }
+
+    uint8_t run[128];
+    int tile_count = _obd->width / INPUT_DISPLAY_TILE_WIDTH;
+
+    for (int page = 0; page < _obd->height / 8; page++) {
+        uint8_t dirty = _dirty_tiles[page];
+        _dirty_tiles[page] = 0;
+
+        // Send each run of adjacent dirty tiles as one block.
+        int tile = 0;
+        while (tile < tile_count) {
+            if (!(dirty & (1 << tile))) {
+                tile++;
+                continue;
+            }
+            int start = tile;
+            while (tile < tile_count && (dirty & (1 << tile))) {
+                tile++;
+            }
+
+            int x = start * INPUT_DISPLAY_TILE_WIDTH;
+            int length = (tile - start) * INPUT_DISPLAY_TILE_WIDTH;
+            uint8_t *data = &_obd->ucScreen[page * _obd->width + x];
+            if (_dma != nullptr) {
+                // The run is copied into the transfer, so the back buffer can be drawn to again
+                // straight away.
+                if (!_dma->AddRun(x, page, data, length)) {
+                    _dirty_tiles[page] |= dirty & ~((1 << start) - 1) & ((1 << tile) - 1);
+                }
+                continue;
+            }
+            memcpy(run, data, length);
+            obdSetPosition(_obd, x, page, 1);
+            obdWriteDataBlock(_obd, run, length, 1);
+        }
+    }
+
+    if (_dma != nullptr) {
+        _dma->Start();
+    }
+}
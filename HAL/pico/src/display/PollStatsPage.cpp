@@ -0,0 +1,51 @@
+#include "display/PollStatsPage.hpp"
+
+#include "core/PollStats.hpp"
+#include "display/InputDisplay.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+// Leave a blank row between the labels and the stats.
+#define FIRST_ROW 2
+
+PollStatsPage::PollStatsPage(InputDisplay *display) {
+    _display = display;
+}
+
+void PollStatsPage::Update(const poll_stats_t &stats) {
+    char text[POLL_STATS_PAGE_LINE_LENGTH];
+    char min_us[11];
+    char max_us[11];
+
+    snprintf(text, sizeof(text), "RATE    %luHZ", (unsigned long)stats.poll_rate);
+    SetLine(0, text);
+
+    FormatMicros(min_us, sizeof(min_us), stats.min_latency_us);
+    FormatMicros(max_us, sizeof(max_us), stats.max_latency_us);
+    snprintf(text, sizeof(text), "LATENCY %s-%sUS", min_us, max_us);
+    SetLine(1, text);
+
+    FormatMicros(min_us, sizeof(min_us), stats.min_slack_us);
+    snprintf(text, sizeof(text), "SLACK   %sUS", min_us);
+    SetLine(2, text);
+
+    snprintf(text, sizeof(text), "SKIPPED %lu", (unsigned long)stats.skipped_polls);
+    SetLine(3, text);
+}
+
+void PollStatsPage::SetLine(int line, const char *text) {
+    if (strcmp(_lines[line], text) == 0) {
+        return;
+    }
+    strcpy(_lines[line], text);
+    _display->DrawText(FIRST_ROW + line, _lines[line]);
+}
+
+void PollStatsPage::FormatMicros(char *buffer, size_t size, uint32_t value_us) {
+    if (value_us == POLL_STATS_NO_SAMPLES) {
+        snprintf(buffer, size, "-");
+    } else {
+        snprintf(buffer, size, "%lu", (unsigned long)value_us);
+    }
+}
@@ -0,0 +1,83 @@
+#include "display/StickDisplay.hpp"
+
+#include "core/state.hpp"
+#include "display/InputDisplay.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#define BOX_TOP 10
+#define DOT_SIZE 2
+// Dots are kept inside the border, so the border never has to be redrawn.
+#define DOT_RANGE (STICK_DISPLAY_BOX_SIZE - 2 - DOT_SIZE)
+#define TEXT_ROW 7
+
+static const int box_left[2] = { 14, 74 };
+
+StickDisplay::StickDisplay(InputDisplay *display) {
+    _display = display;
+
+    for (int stick = 0; stick < 2; stick++) {
+        _display->DrawRect(
+            box_left[stick],
+            BOX_TOP,
+            box_left[stick] + STICK_DISPLAY_BOX_SIZE - 1,
+            BOX_TOP + STICK_DISPLAY_BOX_SIZE - 1,
+            true,
+            false
+        );
+        DrawCenter(stick);
+    }
+}
+
+void StickDisplay::Update(const StickSnapshot &sticks) {
+    MoveDot(0, sticks.left_x, sticks.left_y);
+    MoveDot(1, sticks.right_x, sticks.right_y);
+
+    char text[STICK_DISPLAY_LINE_LENGTH];
+    snprintf(
+        text,
+        sizeof(text),
+        "L%3u,%3u  R%3u,%3u",
+        sticks.left_x,
+        sticks.left_y,
+        sticks.right_x,
+        sticks.right_y
+    );
+    if (strcmp(text, _coordinates) != 0) {
+        strcpy(_coordinates, text);
+        _display->DrawText(TEXT_ROW, _coordinates);
+    }
+}
+
+void StickDisplay::MoveDot(int stick, uint8_t x, uint8_t y) {
+    // Up is positive on the stick but down on the screen.
+    int dot_x = box_left[stick] + 1 + x * DOT_RANGE / 255;
+    int dot_y = BOX_TOP + 1 + (255 - y) * DOT_RANGE / 255;
+    if (dot_x == _dot_x[stick] && dot_y == _dot_y[stick]) {
+        return;
+    }
+
+    if (_dot_x[stick] >= 0) {
+        _display->DrawRect(
+            _dot_x[stick],
+            _dot_y[stick],
+            _dot_x[stick] + DOT_SIZE - 1,
+            _dot_y[stick] + DOT_SIZE - 1,
+            false,
+            true
+        );
+        // The old dot may have covered the center mark.
+        DrawCenter(stick);
+    }
+
+    _display->DrawRect(dot_x, dot_y, dot_x + DOT_SIZE - 1, dot_y + DOT_SIZE - 1, true, true);
+    _dot_x[stick] = dot_x;
+    _dot_y[stick] = dot_y;
+}
+
+void StickDisplay::DrawCenter(int stick) {
+    int center_x = box_left[stick] + STICK_DISPLAY_BOX_SIZE / 2 - 1;
+    int center_y = BOX_TOP + STICK_DISPLAY_BOX_SIZE / 2 - 1;
+    _display->DrawRect(center_x, center_y, center_x, center_y, true, true);
+}
@@ -0,0 +1,93 @@
+#include "display/custom_layout.hpp"
+
+#include "core/input_mask.hpp"
+#include "display/InputDisplay.hpp"
+#include "persistent_storage.hpp"
+#include "serial.hpp"
+
+#define CUSTOM_LAYOUT_MAGIC 0xD1
+#define ENTRY_SIZE 4
+
+typedef struct {
+    uint8_t button_count;
+    uint8_t entries[INPUT_DISPLAY_MAX_BUTTONS * ENTRY_SIZE];
+} stored_layout_t;
+
+namespace custom_layout {
+    static DisplayButton buttons[INPUT_DISPLAY_MAX_BUTTONS];
+
+    static stored_layout_t upload;
+    static size_t upload_pos = 0;
+    static uint8_t upload_checksum = 0;
+
+    static bool decode(const stored_layout_t &stored, DisplayButton *decoded) {
+        if (stored.button_count > INPUT_DISPLAY_MAX_BUTTONS) {
+            return false;
+        }
+        for (size_t i = 0; i < stored.button_count; i++) {
+            const uint8_t *entry = &stored.entries[i * ENTRY_SIZE];
+            bool InputState::*input = input_mask::member(entry[0]);
+            if (input == nullptr || entry[1] >= (uint8_t)ButtonShape::SHAPE_COUNT) {
+                return false;
+            }
+            decoded[i] = { input, (ButtonShape)entry[1], entry[2], entry[3] };
+        }
+        return true;
+    }
+
+    bool load(ButtonLayout &layout) {
+        stored_layout_t stored;
+        if (!persistent_storage::read(
+                STORAGE_CUSTOM_LAYOUT_ADDR,
+                CUSTOM_LAYOUT_MAGIC,
+                &stored,
+                sizeof(stored)
+            ) ||
+            !decode(stored, buttons)) {
+            return false;
+        }
+        layout = { buttons, stored.button_count };
+        return true;
+    }
+
+    bool receive() {
+        while (serial::available() > 0) {
+            uint8_t byte = serial::read();
+
+            // Position 0 is the header, 1 the count, then the entries, then the checksum.
+            if (upload_pos == 0) {
+                if (byte == CUSTOM_LAYOUT_HEADER) {
+                    upload_checksum = byte;
+                    upload_pos++;
+                }
+                continue;
+            }
+
+            size_t entries_end = 2 + upload.button_count * ENTRY_SIZE;
+            if (upload_pos == 1) {
+                if (byte > INPUT_DISPLAY_MAX_BUTTONS) {
+                    upload_pos = 0;
+                    continue;
+                }
+                upload.button_count = byte;
+            } else if (upload_pos < entries_end) {
+                upload.entries[upload_pos - 2] = byte;
+            } else {
+                upload_pos = 0;
+                DisplayButton decoded[INPUT_DISPLAY_MAX_BUTTONS];
+                if (byte != upload_checksum || !decode(upload, decoded)) {
+                    continue;
+                }
+                return persistent_storage::stage(
+                    STORAGE_CUSTOM_LAYOUT_ADDR,
+                    CUSTOM_LAYOUT_MAGIC,
+                    &upload,
+                    sizeof(upload)
+                );
+            }
+            upload_checksum ^= byte;
+            upload_pos++;
+        }
+        return false;
+    }
+}
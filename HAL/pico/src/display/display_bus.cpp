@@ -0,0 +1,41 @@
+#include "display/display_bus.hpp"
+
+#include <lib/OneBitDisplay/OneBitDisplay.h>
+
+namespace display_bus {
+    void init(OBDISP *obd, const DisplayPinout &pinout, int type, int flip, int invert) {
+        if (pinout.bus == DisplayBus::SPI) {
+            // OneBitDisplay takes the SPI block from the I2C settings, which aren't otherwise used.
+            obd->bbi2c.picoSPI = pinout.spi;
+            obdSPIInit(
+                obd,
+                type,
+                pinout.dc,
+                pinout.cs,
+                pinout.reset,
+                pinout.mosi,
+                pinout.sck,
+                -1,
+                flip,
+                invert,
+                0,
+                pinout.speed
+            );
+            return;
+        }
+
+        obdI2CInit(
+            obd,
+            type,
+            pinout.address,
+            flip,
+            invert,
+            1,
+            pinout.sda,
+            pinout.scl,
+            pinout.i2c,
+            -1,
+            pinout.speed
+        );
+    }
+}
@@ -0,0 +1,33 @@
+#include "i2c_bus.hpp"
+
+#include "stdlib.hpp"
+
+#include <hardware/dma.h>
+#include <hardware/i2c.h>
+
+namespace i2c_bus {
+    static int dma_channels[2] = { -1, -1 };
+
+    void attach_dma(i2c_inst_t *i2c, int channel) {
+        dma_channels[i2c_hw_index(i2c)] = channel;
+    }
+
+    bool idle(i2c_inst_t *i2c) {
+        int channel = dma_channels[i2c_hw_index(i2c)];
+        if (channel >= 0 && dma_channel_is_busy(channel)) {
+            return false;
+        }
+        return i2c->hw->txflr == 0 && i2c->hw->rxflr == 0 &&
+               !(i2c->hw->status & I2C_IC_STATUS_ACTIVITY_BITS) &&
+               !(i2c->hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS);
+    }
+
+    void set_target(i2c_inst_t *i2c, uint16_t address) {
+        if (i2c->hw->tar == address) {
+            return;
+        }
+        i2c->hw->enable = 0;
+        i2c->hw->tar = address;
+        i2c->hw->enable = 1;
+    }
+}
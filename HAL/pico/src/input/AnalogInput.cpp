@@ -0,0 +1,130 @@
+#include "input/AnalogInput.hpp"
+
+#include "core/analog.hpp"
+
+#include <hardware/adc.h>
+#include <hardware/dma.h>
+
+#define ADC_FIRST_PIN 26
+#define ADC_INPUT_COUNT 4
+
+AnalogInput::AnalogInput(AnalogChannelMapping *channel_mappings, size_t channel_count) {
+    _channel_mappings = channel_mappings;
+    _channel_count = 0;
+    _round_size = 0;
+    _sample_slots = nullptr;
+    _samples = nullptr;
+    _samples_start = nullptr;
+
+    // Any pin other than an ADC pin would select the wrong ADC input, or one that doesn't exist, so
+    // a mapping with one leaves the whole input source disabled. So does having nothing to sample.
+    if (channel_count == 0) {
+        return;
+    }
+    for (size_t i = 0; i < channel_count; i++) {
+        uint pin = channel_mappings[i].pin;
+        if (pin < ADC_FIRST_PIN || pin >= ADC_FIRST_PIN + ADC_INPUT_COUNT) {
+            return;
+        }
+    }
+
+    _channel_count = channel_count;
+    _sample_slots = new uint8_t[channel_count];
+
+    adc_init();
+
+    // The ADC goes through the enabled inputs in ascending order, so a mapping's position in each
+    // round of samples is the number of enabled inputs below it.
+    uint input_mask = 0;
+    for (size_t i = 0; i < _channel_count; i++) {
+        uint pin = _channel_mappings[i].pin;
+        adc_gpio_init(pin);
+        input_mask |= 1 << (pin - ADC_FIRST_PIN);
+    }
+    uint slot_of_input[ADC_INPUT_COUNT];
+    for (uint input = 0; input < ADC_INPUT_COUNT; input++) {
+        if (input_mask & (1 << input)) {
+            slot_of_input[input] = _round_size++;
+        }
+    }
+    for (size_t i = 0; i < _channel_count; i++) {
+        _sample_slots[i] = slot_of_input[_channel_mappings[i].pin - ADC_FIRST_PIN];
+    }
+
+    size_t sample_count = _round_size * ANALOG_SAMPLES_PER_CHANNEL;
+    _samples = new uint16_t[sample_count]();
+    _samples_start = _samples;
+
+    adc_select_input(__builtin_ctz(input_mask));
+    adc_set_round_robin(input_mask);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(0);
+
+    // The sample channel fills the buffer once, then triggers the control channel which points it
+    // back at the start of the buffer and restarts it, forever.
+    _sample_dma = dma_claim_unused_channel(true);
+    _control_dma = dma_claim_unused_channel(true);
+
+    dma_channel_config sample_config = dma_channel_get_default_config(_sample_dma);
+    channel_config_set_transfer_data_size(&sample_config, DMA_SIZE_16);
+    channel_config_set_read_increment(&sample_config, false);
+    channel_config_set_write_increment(&sample_config, true);
+    channel_config_set_dreq(&sample_config, DREQ_ADC);
+    channel_config_set_chain_to(&sample_config, _control_dma);
+    dma_channel_configure(
+        _sample_dma,
+        &sample_config,
+        _samples,
+        &adc_hw->fifo,
+        sample_count,
+        false
+    );
+
+    dma_channel_config control_config = dma_channel_get_default_config(_control_dma);
+    channel_config_set_transfer_data_size(&control_config, DMA_SIZE_32);
+    channel_config_set_read_increment(&control_config, false);
+    channel_config_set_write_increment(&control_config, false);
+    dma_channel_configure(
+        _control_dma,
+        &control_config,
+        &dma_hw->ch[_sample_dma].al2_write_addr_trig,
+        &_samples_start,
+        1,
+        false
+    );
+
+    dma_channel_start(_sample_dma);
+    adc_run(true);
+}
+
+AnalogInput::~AnalogInput() {
+    if (_sample_dma < 0) {
+        return;
+    }
+
+    adc_run(false);
+    dma_channel_abort(_control_dma);
+    dma_channel_abort(_sample_dma);
+    dma_channel_unclaim(_control_dma);
+    dma_channel_unclaim(_sample_dma);
+    adc_fifo_drain();
+    delete[] _samples;
+    delete[] _sample_slots;
+}
+
+InputScanSpeed AnalogInput::ScanSpeed() {
+    return InputScanSpeed::FAST;
+}
+
+void AnalogInput::UpdateInputs(InputState &inputs) {
+    for (size_t i = 0; i < _channel_count; i++) {
+        AnalogChannelMapping &mapping = _channel_mappings[i];
+        uint16_t raw = analog::average(
+            _samples,
+            _round_size,
+            ANALOG_SAMPLES_PER_CHANNEL,
+            _sample_slots[i]
+        );
+        inputs.*(mapping.value) = analog::calibrate(raw, mapping.calibration);
+    }
+}
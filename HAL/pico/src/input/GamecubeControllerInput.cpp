@@ -3,6 +3,12 @@
 #include "core/InputSource.hpp"
 
 #include <GamecubeController.hpp>
+#include <pico/time.h>
+
+// GamecubeController::Poll() waits until the library's own polling interval has passed since the
+// last poll. The interval is kept here without waiting instead, so the library is given one that
+// has always passed by the time the next poll is due.
+#define LIBRARY_POLLING_RATE 1000000
 
 GamecubeControllerInput::GamecubeControllerInput(
     uint pin,
@@ -11,7 +17,9 @@ GamecubeControllerInput::GamecubeControllerInput(
     int sm,
     int offset
 ) {
-    _controller = new GamecubeController(pin, polling_rate, pio, sm, offset);
+    _controller = new GamecubeController(pin, LIBRARY_POLLING_RATE, pio, sm, offset);
+    _poll_interval_us = 1000000 / polling_rate;
+    _next_poll = get_absolute_time();
 }
 
 GamecubeControllerInput::~GamecubeControllerInput() {
@@ -23,13 +31,77 @@ InputScanSpeed GamecubeControllerInput::ScanSpeed() {
 }
 
 void GamecubeControllerInput::UpdateInputs(InputState &inputs) {
-    // Only update inputs if poll response is received.
-    if (_controller->Poll(&_report, false)) {
-        inputs.nunchuk_connected = true;
-        inputs.nunchuk_x = _report.stick_x;
-        inputs.nunchuk_y = _report.stick_y;
-        inputs.nunchuk_z = _report.l;
+    // Only poll the controller when a poll is due. Otherwise reuse the last report.
+    if (time_reached(_next_poll)) {
+        _next_poll = make_timeout_time_us(_poll_interval_us);
+        bool was_connected = _connected;
+        _connected = _controller->Poll(&_report, false);
+        // If the controller stops answering, e.g. because it was unplugged, don't leave its last
+        // report held down.
+        if (!_connected && was_connected) {
+            ClearInputs(inputs);
+        }
+    }
+
+    if (!_connected) {
+        return;
     }
+
+    inputs.nunchuk_connected = true;
+    inputs.nunchuk_x = _report.stick_x;
+    inputs.nunchuk_y = _report.stick_y;
+    inputs.nunchuk_z = _report.l;
+
+    inputs.analog_stick_x = _report.stick_x;
+    inputs.analog_stick_y = _report.stick_y;
+    inputs.analog_cstick_x = _report.cstick_x;
+    inputs.analog_cstick_y = _report.cstick_y;
+    inputs.analog_trigger_l = _report.l_analog;
+    inputs.analog_trigger_r = _report.r_analog;
+
+    inputs.gcc_connected = true;
+    inputs.gcc_a = _report.a;
+    inputs.gcc_b = _report.b;
+    inputs.gcc_x = _report.x;
+    inputs.gcc_y = _report.y;
+    inputs.gcc_z = _report.z;
+    inputs.gcc_l = _report.l;
+    inputs.gcc_r = _report.r;
+    inputs.gcc_start = _report.start;
+    inputs.gcc_dpad_up = _report.dpad_up;
+    inputs.gcc_dpad_down = _report.dpad_down;
+    inputs.gcc_dpad_left = _report.dpad_left;
+    inputs.gcc_dpad_right = _report.dpad_right;
+}
+
+void GamecubeControllerInput::ClearInputs(InputState &inputs) {
+    const InputState idle;
+
+    inputs.nunchuk_connected = idle.nunchuk_connected;
+    inputs.nunchuk_x = idle.nunchuk_x;
+    inputs.nunchuk_y = idle.nunchuk_y;
+    inputs.nunchuk_z = idle.nunchuk_z;
+
+    inputs.analog_stick_x = idle.analog_stick_x;
+    inputs.analog_stick_y = idle.analog_stick_y;
+    inputs.analog_cstick_x = idle.analog_cstick_x;
+    inputs.analog_cstick_y = idle.analog_cstick_y;
+    inputs.analog_trigger_l = idle.analog_trigger_l;
+    inputs.analog_trigger_r = idle.analog_trigger_r;
+
+    inputs.gcc_connected = idle.gcc_connected;
+    inputs.gcc_a = idle.gcc_a;
+    inputs.gcc_b = idle.gcc_b;
+    inputs.gcc_x = idle.gcc_x;
+    inputs.gcc_y = idle.gcc_y;
+    inputs.gcc_z = idle.gcc_z;
+    inputs.gcc_l = idle.gcc_l;
+    inputs.gcc_r = idle.gcc_r;
+    inputs.gcc_start = idle.gcc_start;
+    inputs.gcc_dpad_up = idle.gcc_dpad_up;
+    inputs.gcc_dpad_down = idle.gcc_dpad_down;
+    inputs.gcc_dpad_left = idle.gcc_dpad_left;
+    inputs.gcc_dpad_right = idle.gcc_dpad_right;
 }
 
 int GamecubeControllerInput::GetOffset() {
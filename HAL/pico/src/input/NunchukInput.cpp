@@ -1,8 +1,18 @@
 #include "input/NunchukInput.hpp"
 
+#include "core/StickCalibration.hpp"
+#include "core/state.hpp"
 #include "gpio.hpp"
+#include "i2c_bus.hpp"
+#include "persistent_storage.hpp"
 
 #include <Wire.h>
+#include <hardware/i2c.h>
+
+// Time the Nunchuk needs after a conversion request before the next report can be read.
+#define NUNCHUK_CONVERSION_US 200
+
+#define CALIBRATION_MAGIC 0xCA
 
 NunchukInput::NunchukInput(TwoWire &wire, int detect_pin, int sda_pin, int scl_pin) {
     delay(50);
@@ -31,23 +41,157 @@ NunchukInput::NunchukInput(TwoWire &wire, int detect_pin, int sda_pin, int scl_p
         // ends the i2c communication.
         delete _nunchuk;
         _nunchuk = nullptr;
+        return;
+    }
+
+    // From here on the I2C block is driven directly so that reads don't block. It may be shared
+    // with the display, so the target address is set again before each transfer.
+    _i2c = I2cBlock(wire);
+
+    // ArduinoNunchuk::update() finishes by requesting the next conversion.
+    _request_sent_us = micros();
+
+    stick_calibration_t params;
+    _calibrated = persistent_storage::read(
+        STORAGE_NUNCHUK_CALIBRATION_ADDR,
+        CALIBRATION_MAGIC,
+        &params,
+        sizeof(params)
+    );
+    _calibration = new StickCalibration(params);
+    if (_nunchuk->buttonC() && _nunchuk->buttonZ()) {
+        _calibration->StartCapture();
     }
 }
 
 NunchukInput::~NunchukInput() {
     delete _nunchuk;
+    delete _calibration;
 }
 
 InputScanSpeed NunchukInput::ScanSpeed() {
     return InputScanSpeed::SLOW;
 }
 
+bool NunchukInput::CheckAbort() {
+    if (!(_i2c->hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+        return false;
+    }
+
+    // Clear the abort and throw away anything that was received before it happened.
+    (void)_i2c->hw->clr_tx_abrt;
+    while (_i2c->hw->rxflr > 0) {
+        (void)_i2c->hw->data_cmd;
+    }
+    _state = TransferState::IDLE;
+    _request_sent_us = micros();
+    return true;
+}
+
 void NunchukInput::UpdateInputs(InputState &inputs) {
-    if (_nunchuk != nullptr && _nunchuk->update()) {
-        inputs.nunchuk_connected = true;
-        inputs.nunchuk_x = _nunchuk->stickX();
-        inputs.nunchuk_y = _nunchuk->stickY();
-        inputs.nunchuk_c = _nunchuk->buttonC();
-        inputs.nunchuk_z = _nunchuk->buttonZ();
+    if (_nunchuk == nullptr) {
+        return;
+    }
+    // Only an abort during the Nunchuk's own transfer is cleared here. One during the display's is
+    // left for the display to see.
+    if (_state != TransferState::IDLE && CheckAbort()) {
+        return;
+    }
+
+    switch (_state) {
+        case TransferState::IDLE:
+            // Wait for the conversion, and for a display sharing the block to finish with it.
+            if (micros() - _request_sent_us < NUNCHUK_CONVERSION_US || !i2c_bus::idle(_i2c)) {
+                return;
+            }
+            i2c_bus::set_target(_i2c, NUNCHUK_I2C_ADDR);
+            // Queue the read commands. They fit in the TX FIFO, so this never waits.
+            for (size_t i = 0; i < NUNCHUK_REPORT_SIZE; i++) {
+                bool last = i == NUNCHUK_REPORT_SIZE - 1;
+                _i2c->hw->data_cmd = I2C_IC_DATA_CMD_CMD_BITS |
+                                     (last ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+            }
+            _state = TransferState::READING;
+            return;
+        case TransferState::READING: {
+            if (_i2c->hw->rxflr < NUNCHUK_REPORT_SIZE) {
+                return;
+            }
+            uint8_t report[NUNCHUK_REPORT_SIZE];
+            for (size_t i = 0; i < NUNCHUK_REPORT_SIZE; i++) {
+                report[i] = (uint8_t)_i2c->hw->data_cmd;
+            }
+            DecodeReport(report, inputs);
+            UpdateCalibration(inputs, inputs.nunchuk_c, inputs.nunchuk_z);
+
+            // Ask the Nunchuk to start converting the next report. The block has been busy with the
+            // read until now, so nothing else can have used it in between.
+            _i2c->hw->data_cmd = 0x00 | I2C_IC_DATA_CMD_STOP_BITS;
+            _state = TransferState::REQUESTING;
+            return;
+        }
+        case TransferState::REQUESTING:
+            // Wait for the request to be sent before timing the conversion.
+            if (_i2c->hw->txflr > 0 || (_i2c->hw->status & I2C_IC_STATUS_ACTIVITY_BITS)) {
+                return;
+            }
+            _request_sent_us = micros();
+            _state = TransferState::IDLE;
+            return;
+    }
+}
+
+void NunchukInput::UpdateCalibration(InputState &inputs, bool c, bool z) {
+    uint8_t x = inputs.nunchuk_x;
+    uint8_t y = inputs.nunchuk_y;
+
+    if (!_calibration->Capturing()) {
+        if (_calibrated) {
+            _calibration->Apply(x, y);
+            inputs.nunchuk_x = x;
+            inputs.nunchuk_y = y;
+        }
+        return;
     }
+
+    // C and Z are still held from starting the capture until they are first released.
+    if (!c && !z) {
+        _capture_released = true;
+    }
+    if (_capture_released && c && z) {
+        _calibration->FinishCapture();
+        // Writing to flash stalls both cores, so a few polls are missed. That is accepted because
+        // the user asked for the save, and a console keeps polling for as long as it powers the
+        // controller, so there may never be a better time.
+        persistent_storage::write(
+            STORAGE_NUNCHUK_CALIBRATION_ADDR,
+            CALIBRATION_MAGIC,
+            &_calibration->GetParams(),
+            sizeof(stick_calibration_t)
+        );
+        _calibrated = true;
+        return;
+    }
+
+    _calibration->CaptureSample(x, y);
+
+    // Don't send stick movements to the game while calibrating.
+    inputs.nunchuk_x = 128;
+    inputs.nunchuk_y = 128;
+    inputs.nunchuk_c = false;
+    inputs.nunchuk_z = false;
+}
+
+void NunchukInput::DecodeReport(const uint8_t *report, InputState &inputs) {
+    inputs.nunchuk_connected = true;
+    // Stick values are stored unconverted, centered on 128, same as ArduinoNunchuk reports them.
+    inputs.nunchuk_x = report[0];
+    inputs.nunchuk_y = report[1];
+    // Buttons are active low.
+    inputs.nunchuk_z = !(report[5] & 0x01);
+    inputs.nunchuk_c = !(report[5] & 0x02);
+}
+
+i2c_inst_t *NunchukInput::I2cBlock(TwoWire &wire) {
+    return &wire == &Wire1 ? i2c1 : i2c0;
 }
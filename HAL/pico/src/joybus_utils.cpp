@@ -1,22 +1,129 @@
 #include "joybus_utils.hpp"
 
+#include "persistent_storage.hpp"
+
 #include <GamecubeConsole.hpp>
 #include <N64Console.hpp>
 
 #define VBUS_SENSE_PIN 24
 
+#define CONSOLE_HINT_MAGIC 0xC5
+
+static bool detection_done = false;
+static ConnectedConsole detected_console = ConnectedConsole::NONE;
+static uint detected_pin;
+static GamecubeConsole *detected_gamecube = nullptr;
+static N64Console *detected_n64 = nullptr;
+
+static ConnectedConsole read_console_hint() {
+    uint8_t value;
+    if (persistent_storage::read(STORAGE_CONSOLE_HINT_ADDR, CONSOLE_HINT_MAGIC, &value, 1) &&
+        value <= (uint8_t)ConnectedConsole::NONE) {
+        return (ConnectedConsole)value;
+    }
+    return ConnectedConsole::NONE;
+}
+
+static void write_console_hint(ConnectedConsole console) {
+    // Only touches flash if the console actually changed.
+    uint8_t value = (uint8_t)console;
+    persistent_storage::write(STORAGE_CONSOLE_HINT_ADDR, CONSOLE_HINT_MAGIC, &value, 1);
+}
+
+static bool probe_console(ConnectedConsole console, uint joybus_pin) {
+    if (console == ConnectedConsole::GAMECUBE) {
+        GamecubeConsole *gamecube = new GamecubeConsole(joybus_pin);
+        if (gamecube->Detect()) {
+            detected_gamecube = gamecube;
+            return true;
+        }
+        delete gamecube;
+    } else if (console == ConnectedConsole::N64) {
+        N64Console *n64 = new N64Console(joybus_pin);
+        if (n64->Detect()) {
+            detected_n64 = n64;
+            return true;
+        }
+        delete n64;
+    }
+    return false;
+}
+
+size_t console_probe_order(ConnectedConsole hint, bool vbus_powered, ConnectedConsole order[2]) {
+    size_t count = 0;
+
+    // 5V is not connected when plugged into N64, so only probe for one if VBUS isn't powered.
+    bool n64_possible = !vbus_powered;
+
+    // If we were plugged into an N64 last time, check for that first so we don't waste time
+    // waiting for GameCube traffic that will never come.
+    if (n64_possible && hint == ConnectedConsole::N64) {
+        order[count++] = ConnectedConsole::N64;
+    }
+    order[count++] = ConnectedConsole::GAMECUBE;
+    if (n64_possible && hint != ConnectedConsole::N64) {
+        order[count++] = ConnectedConsole::N64;
+    }
+
+    return count;
+}
+
 ConnectedConsole detect_console(uint joybus_pin) {
+    if (detection_done) {
+        return detected_console;
+    }
+
     gpio_init(VBUS_SENSE_PIN);
     gpio_set_dir(VBUS_SENSE_PIN, GPIO_IN);
     bool vbus_powered = gpio_get(VBUS_SENSE_PIN);
 
-    if (GamecubeConsole(joybus_pin).Detect()) {
-        return ConnectedConsole::GAMECUBE;
+    ConnectedConsole hint = read_console_hint();
+
+    // Each probe is bounded by the console library's detection timeout, and there are at most two.
+    ConnectedConsole order[2];
+    size_t probe_count = console_probe_order(hint, vbus_powered, order);
+    for (size_t i = 0; i < probe_count; i++) {
+        if (probe_console(order[i], joybus_pin)) {
+            detected_console = order[i];
+            break;
+        }
     }
-    // 5V is not connected when plugged into N64 so we check that first to save time.
-    if (!vbus_powered && N64Console(joybus_pin).Detect()) {
-        return ConnectedConsole::N64;
+
+    write_console_hint(detected_console);
+
+    detected_pin = joybus_pin;
+    detection_done = true;
+    return detected_console;
+}
+
+GamecubeConsole *take_detected_gamecube(uint joybus_pin, PIO pio, int sm, int offset) {
+    GamecubeConsole *gamecube = detected_gamecube;
+    detected_gamecube = nullptr;
+    if (gamecube == nullptr) {
+        return nullptr;
     }
 
-    return ConnectedConsole::NONE;
-}
\ No newline at end of file
+    // The detection instance was created with the default PIO, state machine and offset.
+    if (joybus_pin != detected_pin || pio != pio0 || sm >= 0 ||
+        (offset >= 0 && offset != gamecube->GetOffset())) {
+        delete gamecube;
+        return nullptr;
+    }
+    return gamecube;
+}
+
+N64Console *take_detected_n64(uint joybus_pin, PIO pio, int sm, int offset) {
+    N64Console *n64 = detected_n64;
+    detected_n64 = nullptr;
+    if (n64 == nullptr) {
+        return nullptr;
+    }
+
+    // The detection instance was created with the default PIO, state machine and offset.
+    if (joybus_pin != detected_pin || pio != pio0 || sm >= 0 ||
+        (offset >= 0 && offset != n64->GetOffset())) {
+        delete n64;
+        return nullptr;
+    }
+    return n64;
+}
@@ -0,0 +1,118 @@
+#include "persistent_storage.hpp"
+
+#include <EEPROM.h>
+#include <pico/mutex.h>
+
+#define STORAGE_SIZE 256
+
+typedef struct {
+    uint addr;
+    size_t size;
+} staged_record_t;
+
+// Both cores read records during setup, and the EEPROM emulation isn't safe to use from both at
+// once.
+auto_init_mutex(storage_mutex);
+
+// Staged records are kept at their own addresses in a copy of the storage.
+static uint8_t staged_data[STORAGE_SIZE];
+static staged_record_t staged_records[STORAGE_MAX_STAGED];
+static volatile size_t staged_count = 0;
+
+namespace persistent_storage {
+    // Copies a record into the EEPROM buffer, which must have been begun. Returns true if it
+    // differed from the stored record.
+    static bool put(uint addr, uint8_t magic, const uint8_t *data, size_t size) {
+        bool changed = EEPROM.read(addr) != magic;
+        EEPROM.write(addr, magic);
+        for (size_t i = 0; i < size; i++) {
+            changed |= EEPROM.read(addr + 1 + i) != data[i];
+            EEPROM.write(addr + 1 + i, data[i]);
+        }
+        return changed;
+    }
+
+    bool read(uint addr, uint8_t magic, void *data, size_t size) {
+        if (addr + 1 + size > STORAGE_SIZE) {
+            return false;
+        }
+
+        mutex_enter_blocking(&storage_mutex);
+        EEPROM.begin(STORAGE_SIZE);
+        bool valid = EEPROM.read(addr) == magic;
+        if (valid) {
+            for (size_t i = 0; i < size; i++) {
+                ((uint8_t *)data)[i] = EEPROM.read(addr + 1 + i);
+            }
+        }
+        EEPROM.end();
+        mutex_exit(&storage_mutex);
+
+        return valid;
+    }
+
+    void write(uint addr, uint8_t magic, const void *data, size_t size) {
+        if (addr + 1 + size > STORAGE_SIZE) {
+            return;
+        }
+
+        mutex_enter_blocking(&storage_mutex);
+        EEPROM.begin(STORAGE_SIZE);
+        if (put(addr, magic, (const uint8_t *)data, size)) {
+            EEPROM.commit();
+        }
+        EEPROM.end();
+        mutex_exit(&storage_mutex);
+    }
+
+    bool stage(uint addr, uint8_t magic, const void *data, size_t size) {
+        if (addr + 1 + size > STORAGE_SIZE) {
+            return false;
+        }
+
+        mutex_enter_blocking(&storage_mutex);
+        size_t i = 0;
+        while (i < staged_count && staged_records[i].addr != addr) {
+            i++;
+        }
+        bool fits = i < STORAGE_MAX_STAGED;
+        if (fits) {
+            staged_records[i] = { addr, size };
+            staged_data[addr] = magic;
+            memcpy(&staged_data[addr + 1], data, size);
+            if (i == staged_count) {
+                staged_count = i + 1;
+            }
+        }
+        mutex_exit(&storage_mutex);
+
+        return fits;
+    }
+
+    bool staged() {
+        return staged_count > 0;
+    }
+
+    void commit_staged() {
+        mutex_enter_blocking(&storage_mutex);
+        if (staged_count > 0) {
+            EEPROM.begin(STORAGE_SIZE);
+            bool changed = false;
+            for (size_t i = 0; i < staged_count; i++) {
+                uint addr = staged_records[i].addr;
+                changed |= put(
+                    addr,
+                    staged_data[addr],
+                    &staged_data[addr + 1],
+                    staged_records[i].size
+                );
+            }
+            if (changed) {
+                EEPROM.commit();
+            }
+            EEPROM.end();
+            staged_count = 0;
+        }
+        mutex_exit(&storage_mutex);
+    }
+}
@@ -28,4 +28,16 @@ namespace serial {
     int available_for_write() {
         return Serial.availableForWrite();
     }
+
+    int available() {
+        return Serial.available();
+    }
+
+    int read() {
+        return Serial.read();
+    }
+
+    bool connected() {
+        return (bool)Serial;
+    }
 }
\ No newline at end of file
@@ -89,14 +89,16 @@ void setup() {
             backend_count = 2;
             primary_backend = new DInputBackend(input_sources, input_source_count);
             backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+                primary_backend,
+                new B0XXInputViewer(input_sources, input_source_count, primary_backend)
             };
         } else {
             // Default to XInput mode if no console detected and no other mode forced.
             backend_count = 2;
             primary_backend = new XInputBackend(input_sources, input_source_count);
             backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+                primary_backend,
+                new B0XXInputViewer(input_sources, input_source_count, primary_backend)
             };
         }
     } else {
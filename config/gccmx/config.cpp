@@ -82,7 +82,8 @@ void setup() {
         // Input viewer only used when connected to PC i.e. when using DInput mode.
         backend_count = 2;
         backends = new CommunicationBackend *[backend_count] {
-            primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+            primary_backend,
+            new B0XXInputViewer(input_sources, input_source_count, primary_backend)
         };
     } else {
         delete primary_backend;
@@ -28,6 +28,7 @@ void set_mode(CommunicationBackend *backend, KeyboardMode *mode) {
 
     // Unset the current controller mode so backend only gives neutral inputs.
     backend->SetGameMode(nullptr);
+    backend->SetModeInfo(&mode->Info());
 }
 
 void select_mode(CommunicationBackend *backend) {
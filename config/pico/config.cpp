@@ -1,6 +1,7 @@
 #include "comms/B0XXInputViewer.hpp"
 #include "comms/DInputBackend.hpp"
 #include "comms/GamecubeBackend.hpp"
+#include "comms/GamecubeMirrorBackend.hpp"
 #include "comms/N64Backend.hpp"
 #include "comms/NintendoSwitchBackend.hpp"
 #include "comms/XInputBackend.hpp"
@@ -8,31 +9,67 @@
 #include "core/CommunicationBackend.hpp"
 #include "core/InputMode.hpp"
 #include "core/KeyboardMode.hpp"
+#include "core/TraceRecorder.hpp"
+#include "core/boot_profile.hpp"
 #include "core/pinout.hpp"
 #include "core/socd.hpp"
 #include "core/state.hpp"
+#include "display/FrameScheduler.hpp"
+#include "display/InputDisplay.hpp"
+#include "display/PollStatsPage.hpp"
+#include "display/StickDisplay.hpp"
+#include "display/custom_layout.hpp"
+#include "display/display_bus.hpp"
+#include "display/layouts.hpp"
 #include "input/GpioButtonInput.hpp"
 #include "input/NunchukInput.hpp"
 #include "joybus_utils.hpp"
 #include "modes/Melee20Button.hpp"
+#include "persistent_storage.hpp"
+#include "serial.hpp"
 #include "stdlib.hpp"
 
 #include <pico/bootrom.h>
 
 //OLED stuff
 #include <lib/OneBitDisplay/OneBitDisplay.h>
-#include <string>
-#include <cstring>
-std::string dispCommBackend = "BACKEND";
-std::string dispMode = "MODE";
-std::string leftLayout;
-std::string centerLayout;
-std::string rightLayout;
 
 CommunicationBackend **backends = nullptr;
 size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
+// Set to 1 to stream a trace of every poll over USB serial when connected to a console. Use
+// tools/decode_trace.py to decode it.
+#ifndef TRACE_RECORDER_ENABLED
+#define TRACE_RECORDER_ENABLED 0
+#endif
+
+TraceRecorder *trace_recorder = nullptr;
+
+// Set to a GPIO pin number to mirror the GameCube port to a second Joybus port on that pin, e.g.
+// for a capture adapter. The mirror port is served by core1, which reads the Nunchuk and updates
+// the display in between its polls.
+#ifndef JOYBUS_MIRROR_PIN
+#define JOYBUS_MIRROR_PIN -1
+#endif
+
+GamecubeMirrorBackend *mirror_backend = nullptr;
+
+// Set to 1 to send the time at which each boot stage finished over USB serial once a host opens the
+// port. Use tools/decode_trace.py --boot-profile to decode it.
+#ifndef BOOT_PROFILE_ENABLED
+#define BOOT_PROFILE_ENABLED 0
+#endif
+
+bool boot_profile_sent = false;
+
+// Custom display layouts are uploaded over USB serial, so uploads are only accepted while nothing
+// else streams over it, and never alongside the mirror port, whose polls aren't tracked.
+bool layout_upload_enabled = false;
+
+// True if the backends talk to a USB host rather than a console.
+bool usb_backends = false;
+
 GpioButtonMapping button_mappings[] = {
     {&InputState::l,            5 },
     { &InputState::left,        4 },
@@ -89,11 +126,18 @@ void setup() {
     gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
     gpio_put(PICO_DEFAULT_LED_PIN, 1);
 
+    // The console backends don't open the serial port themselves.
+    if (BOOT_PROFILE_ENABLED) {
+        serial::init(115200);
+    }
+
     // Create array of input sources to be used.
     static InputSource *input_sources[] = { gpio_input };
     size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
+    boot_profile::mark(boot_profile::STAGE_INPUT_INIT);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
+    boot_profile::mark(boot_profile::STAGE_CONSOLE_DETECT);
 
     /* Select communication backend. */
     CommunicationBackend *primary_backend;
@@ -104,12 +148,6 @@ void setup() {
             backend_count = 1;
             primary_backend = new NintendoSwitchBackend(input_sources, input_source_count);
             backends = new CommunicationBackend *[backend_count] { primary_backend };
-            dispCommBackend = "SWITCH"; //Display isn't refreshing properly when holding X on plugin and connecting to PC.
-
-            // Default to Ultimate mode on Switch.
-            primary_backend->SetGameMode(new Ultimate(socd::SOCD_2IP));
-            dispMode = "ULT";
-            return;
         } else if (button_holds.z) {
             // If no console detected and Z is held on plugin then use DInput backend.
             TUGamepad::registerDescriptor();
@@ -117,39 +155,65 @@ void setup() {
             backend_count = 2;
             primary_backend = new DInputBackend(input_sources, input_source_count);
             backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+                primary_backend,
+                new B0XXInputViewer(input_sources, input_source_count, primary_backend)
             };
-            dispCommBackend = "DINPUT";
-
         } else {
             // Default to XInput mode if no console detected and no other mode forced.
             backend_count = 2;
             primary_backend = new XInputBackend(input_sources, input_source_count);
             backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+                primary_backend,
+                new B0XXInputViewer(input_sources, input_source_count, primary_backend)
             };
-            dispCommBackend = "XINPUT";
         }
     } else {
         if (console == ConnectedConsole::GAMECUBE) {
-            primary_backend =
+            GamecubeBackend *gamecube_backend =
                 new GamecubeBackend(input_sources, input_source_count, pinout.joybus_data);
-            dispCommBackend = "GCN";
+            if (JOYBUS_MIRROR_PIN >= 0) {
+                // Use the other PIO block so the mirror port gets its own state machine.
+                mirror_backend =
+                    new GamecubeMirrorBackend(gamecube_backend, JOYBUS_MIRROR_PIN, pio1);
+            }
+            primary_backend = gamecube_backend;
         } else if (console == ConnectedConsole::N64) {
             primary_backend = new N64Backend(input_sources, input_source_count, pinout.joybus_data);
-            dispCommBackend = "N64";
+        }
+
+        if (TRACE_RECORDER_ENABLED) {
+            trace_recorder = new TraceRecorder();
+            primary_backend->SetTraceRecorder(trace_recorder);
         }
 
         // If console then only using 1 backend (no input viewer).
         backend_count = 1;
         backends = new CommunicationBackend *[backend_count] { primary_backend };
     }
+    usb_backends = console == ConnectedConsole::NONE;
 
-    // Default to Melee mode.
-    primary_backend->SetGameMode(
-        new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = false })
-    );
-    dispMode = "MELEE";
+    layout_upload_enabled = trace_recorder == nullptr && mirror_backend == nullptr;
+    for (size_t i = 0; i < backend_count; i++) {
+        if (backends[i]->Info().id == BackendId::B0XX_INPUT_VIEWER) {
+            layout_upload_enabled = false;
+        }
+    }
+    if (layout_upload_enabled) {
+        serial::init(115200);
+    }
+
+    boot_profile::mark(boot_profile::STAGE_BACKEND_INIT);
+
+    if (console == ConnectedConsole::NONE && button_holds.x) {
+        // Default to Ultimate mode on Switch.
+        primary_backend->SetGameMode(new Ultimate(socd::SOCD_2IP));
+    } else {
+        // Default to Melee mode.
+        primary_backend->SetGameMode(
+            new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = false })
+        );
+    }
+    boot_profile::mark(boot_profile::STAGE_MODE_INIT);
 }
 
 void loop() {
@@ -158,10 +222,34 @@ void loop() {
     for (size_t i = 0; i < backend_count; i++) {
         backends[i]->SendReport();
     }
+    boot_profile::mark(boot_profile::STAGE_FIRST_REPORT);
 
     if (current_kb_mode != nullptr) {
         current_kb_mode->SendReport(backends[0]->GetInputs());
     }
+
+    // Send boot stage timings once something is listening on the serial port.
+    if (BOOT_PROFILE_ENABLED && !boot_profile_sent && serial::connected()) {
+        boot_profile_sent = boot_profile::send();
+    }
+
+    // Accept custom display layouts over USB serial. A received layout is only staged, and saved
+    // once it is safe to stall both cores.
+    if (layout_upload_enabled && serial::connected()) {
+        custom_layout::receive();
+    }
+
+    // A USB host never stops polling, but it just tries again if a report is late, so staged
+    // settings are saved here, in between reports. On a console, core1 saves them once the console
+    // stops polling.
+    if (usb_backends && persistent_storage::staged()) {
+        persistent_storage::commit_staged();
+    }
+
+    // Stream out recorded polls in the idle time after the report has been sent.
+    if (trace_recorder != nullptr) {
+        trace_recorder->Drain();
+    }
 }
 
 /* Nunchuk code runs on the second core */
@@ -215,219 +303,197 @@ NunchukInput *nunchuk = nullptr;
 #define DISPLAY_INVERT 0
 #endif
 
-#ifndef DISPLAY_USEWIRE
-#define DISPLAY_USEWIRE 1
+// Set to 1 for a display connected over SPI instead of I2C. The SPI pins have no defaults, because
+// the usual SPI pins are all used for buttons on this board. Any SPI display must have a D/C pin,
+// and CS must be an output pin even if the display has its CS tied low.
+#ifndef DISPLAY_SPI
+#define DISPLAY_SPI 0
+#endif
+
+#ifndef DISPLAY_SPI_BLOCK
+#define DISPLAY_SPI_BLOCK spi0 //Must match the SCK and MOSI pins, like I2C_BLOCK.
+#endif
+
+#ifndef DISPLAY_SPI_SCK_PIN
+#define DISPLAY_SPI_SCK_PIN -1
+#endif
+
+#ifndef DISPLAY_SPI_MOSI_PIN
+#define DISPLAY_SPI_MOSI_PIN -1
+#endif
+
+#ifndef DISPLAY_SPI_CS_PIN
+#define DISPLAY_SPI_CS_PIN -1
+#endif
+
+#ifndef DISPLAY_SPI_DC_PIN
+#define DISPLAY_SPI_DC_PIN -1
+#endif
+
+#ifndef DISPLAY_SPI_RESET_PIN
+#define DISPLAY_SPI_RESET_PIN -1 //Optional.
+#endif
+
+#ifndef DISPLAY_SPI_SPEED
+#define DISPLAY_SPI_SPEED 8000000 //SSD1306 and SH1106 panels are rated for up to 10MHz.
+#endif
+
+#if DISPLAY_SPI && (DISPLAY_SPI_SCK_PIN < 0 || DISPLAY_SPI_MOSI_PIN < 0 || \
+                    DISPLAY_SPI_CS_PIN < 0 || DISPLAY_SPI_DC_PIN < 0)
+#error "DISPLAY_SPI needs the SCK, MOSI, CS and D/C pins to be set"
+#endif
+
+const DisplayPinout display_pinout = {
+    .bus = DISPLAY_SPI ? DisplayBus::SPI : DisplayBus::I2C,
+    .speed = DISPLAY_SPI ? DISPLAY_SPI_SPEED : I2C_SPEED,
+    .i2c = I2C_BLOCK,
+    .sda = I2C_SDA_PIN,
+    .scl = I2C_SCL_PIN,
+    .address = DISPLAY_I2C_ADDR,
+    .spi = DISPLAY_SPI_BLOCK,
+    .sck = DISPLAY_SPI_SCK_PIN,
+    .mosi = DISPLAY_SPI_MOSI_PIN,
+    .cs = DISPLAY_SPI_CS_PIN,
+    .dc = DISPLAY_SPI_DC_PIN,
+    .reset = DISPLAY_SPI_RESET_PIN,
+};
+
+// Maximum number of times per second the display is refreshed. Core1 reads the Nunchuk between
+// refreshes.
+#ifndef DISPLAY_FRAME_RATE
+#define DISPLAY_FRAME_RATE 60
+#endif
+
+// Set to 1 to show the poll rate, latency and skipped polls of the primary backend instead of the
+// input viewer.
+#ifndef DISPLAY_POLL_STATS
+#define DISPLAY_POLL_STATS 0
+#endif
+
+// Set to 1 to plot the stick outputs of the current mode instead of showing the input viewer.
+#ifndef DISPLAY_STICK_VIEWER
+#define DISPLAY_STICK_VIEWER 0
+#endif
+
+// Settings received while connected to a console, i.e. an uploaded layout, are only written to
+// flash once no backend has started a poll for this long, because the write stalls both cores.
+#ifndef STORAGE_COMMIT_IDLE_US
+#define STORAGE_COMMIT_IDLE_US 100000
 #endif
 
 OBDISP obd;
 uint8_t ucBackBuffer[1024];
+InputDisplay *display = nullptr;
+FrameScheduler *frame_scheduler = nullptr;
+PollStatsPage *poll_stats_page = nullptr;
+StickDisplay *stick_display = nullptr;
 
 void setup1() {
+    // Nunchuk and display setup don't depend on anything core0 sets up, so they run in parallel
+    // with console detection and backend setup.
+
+    // Create Nunchuk input source. An I2C display can be on the same I2C block, because both are
+    // only driven from core1 and each waits for the other's transfer to finish.
+    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
+    boot_profile::mark(boot_profile::STAGE_NUNCHUK_INIT);
+
+    // Initialize OLED.
+    display_bus::init(&obd, display_pinout, DISPLAY_SIZE, DISPLAY_FLIP, DISPLAY_INVERT);
+
+    // The back buffer always holds what is on the panel, so that the input display can work out
+    // which parts of it need to be sent again.
+    obdSetBackBuffer(&obd, ucBackBuffer);
+    // Clear screen and render.
+    obdFill(&obd, 0, 1);
+
+    // Configure display layout options. Change the values below to make a selection. A custom
+    // layout uploaded with tools/upload_layout.py takes precedence over these.
+    // Left: CIRCLES, CIRCLES_WASD, SQUARES, SQUARES_WASD, HTANGL
+    LeftLayout left_layout = LeftLayout::CIRCLES;
+    // Center: CIRCLES, CIRCLES_3_BUTTON, SQUARES, SQUARES_3_BUTTON, HTANGL
+    CenterLayout center_layout = CenterLayout::CIRCLES;
+    // Right: CIRCLES, SQUARES, CIRCLES_19_BUTTON, SQUARES_19_BUTTON, HTANGL
+    RightLayout right_layout = RightLayout::CIRCLES;
+
+    display = new InputDisplay(&obd);
+    frame_scheduler = new FrameScheduler(DISPLAY_FRAME_RATE);
+    ButtonLayout custom;
+    if (DISPLAY_POLL_STATS) {
+        poll_stats_page = new PollStatsPage(display);
+    } else if (DISPLAY_STICK_VIEWER) {
+        stick_display = new StickDisplay(display);
+    } else if (custom_layout::load(custom)) {
+        display->AddLayout(custom);
+    } else {
+        display->AddLayout(layouts::get(left_layout));
+        display->AddLayout(layouts::get(center_layout));
+        display->AddLayout(layouts::get(right_layout));
+    }
+    boot_profile::mark(boot_profile::STAGE_DISPLAY_INIT);
+
+    // Wait for core0 to finish setting up the backends before running loop1().
     while (backends == nullptr) {
         tight_loop_contents();
     }
+}
 
-    // Create Nunchuk input source.
-    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
-
-        //Initialize OLED.
-    	obdI2CInit(&obd,
-	    DISPLAY_SIZE,
-		DISPLAY_I2C_ADDR,
-		DISPLAY_FLIP,
-		DISPLAY_INVERT,
-		DISPLAY_USEWIRE,
-		I2C_SDA_PIN,
-		I2C_SCL_PIN,
-		I2C_BLOCK,
-        -1,
-		I2C_SPEED);
-
-        //Configure display layout options. Change the strings below to make a selection.
-        leftLayout = "circles"; // circles, circlesWASD, squares, squaresWASD, htangl
-        centerLayout = "circles"; // circles, circles3Button, squares, squares3Button, htangl
-        rightLayout = "circles"; // circles, squares, circles19Button, squares19Button, htangl
-        
-	    obdSetBackBuffer(&obd, ucBackBuffer);
-        //Clear screen and render.
-        obdFill(&obd, 0, 1);
+bool backends_idle() {
+    for (size_t i = 0; i < backend_count; i++) {
+        if (!backends[i]->GetPollStats().Idle(STORAGE_COMMIT_IDLE_US)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void loop1() {
+    // The mirror port has to answer polls on its own timing, so this waits for its next poll. The
+    // rest runs right after the reply, when the following poll is furthest away, and never blocks.
+    if (mirror_backend != nullptr) {
+        mirror_backend->SendReport();
+    }
+
+    // Only advances the Nunchuk's I2C transfer by one step, so this doesn't hold up rendering.
     if (backends != nullptr) {
         nunchuk->UpdateInputs(backends[0]->GetInputs());
-        busy_wait_us(50);
     }
 
-    //Clear screen but don't send to render yet.
-    obdFill(&obd, 0, 0);
-
-    //Set mode string based on input combination.
-    if (backends[0]->GetInputs().mod_x && !backends[0]->GetInputs().mod_y && backends[0]->GetInputs().start) {
-        if (backends[0]->GetInputs().l) {
-            dispMode = "MELEE";
-        } else if (backends[0]->GetInputs().left) {
-            dispMode = "PM";
-        } else if (backends[0]->GetInputs().down) {
-            dispMode = "ULT";
-        } else if (backends[0]->GetInputs().right) {
-            dispMode = "FGC";
-        } else if (backends[0]->GetInputs().b) {
-            dispMode = "RoA";
-        }
+    if (persistent_storage::staged() && backends_idle()) {
+        persistent_storage::commit_staged();
+    }
+
+    InputState &inputs = backends[0]->GetInputs();
+
+    // Everything above runs on every iteration. The display is only refreshed when a frame is due,
+    // and the frame is skipped if the previous one is still being sent.
+    if (!frame_scheduler->FrameDue(micros())) {
+        return;
+    }
+    if (!display->Ready()) {
+        frame_scheduler->SkipFrame();
+        return;
     }
 
-    // Write communication backend to OLED starting in the top left.
-    char char_dispCommBackend[dispCommBackend.length() + 1];
-    strcpy(char_dispCommBackend, dispCommBackend.c_str()); //convert string to char
-    obdWriteString(&obd, 0, 0, 0, char_dispCommBackend, FONT_6x8, 0, 0);
-
-    // Write current mode to OLED in the top right. 
-    // For the x position of the string, we are subtracting the max position (128 for a 128x64 px display) by the number of characters * the font width in px.
-    char char_dispMode[dispMode.length() + 1];
-    strcpy(char_dispMode, dispMode.c_str()); //convert string to char
-    obdWriteString(&obd, 0, 128-(dispMode.length() * 6), 0, char_dispMode, FONT_6x8, 0, 0);
-
-    // Draw buttons.
-
-    if (leftLayout == "circles")
-    {
-        obdPreciseEllipse(&obd, 6,  29, 4, 4, 1, backends[0]->GetInputs().l);
-        obdPreciseEllipse(&obd, 15, 23, 4, 4, 1, backends[0]->GetInputs().left);
-        obdPreciseEllipse(&obd, 25, 22, 4, 4, 1, backends[0]->GetInputs().down);
-        obdPreciseEllipse(&obd, 35, 27, 4, 4, 1, backends[0]->GetInputs().right);
-        obdPreciseEllipse(&obd, 38, 52, 4, 4, 1, backends[0]->GetInputs().mod_x);
-        obdPreciseEllipse(&obd, 46, 58, 4, 4, 1, backends[0]->GetInputs().mod_y);
-    } else if (leftLayout == "squares")
-    {
-        obdRectangle(&obd,3,26,9,32,1, backends[0]->GetInputs().l);
-        obdRectangle(&obd,12,20,18,26,1, backends[0]->GetInputs().left);
-        obdRectangle(&obd,22,19,28,25,1, backends[0]->GetInputs().down);
-        obdRectangle(&obd,32,24,38,30,1, backends[0]->GetInputs().right);
-        obdRectangle(&obd,35,49,41,55,1, backends[0]->GetInputs().mod_x);
-        obdRectangle(&obd,43,55,49,61,1, backends[0]->GetInputs().mod_y);
-    }else if (leftLayout == "circlesWASD")
-    {
-        obdPreciseEllipse(&obd, 6,  29, 4, 4, 1, backends[0]->GetInputs().l);
-        obdPreciseEllipse(&obd, 15, 23, 4, 4, 1, backends[0]->GetInputs().left);
-        obdPreciseEllipse(&obd, 25, 22, 4, 4, 1, backends[0]->GetInputs().down);
-        obdPreciseEllipse(&obd, 29, 13, 4, 4, 1, backends[0]->GetInputs().up);
-        obdPreciseEllipse(&obd, 35, 27, 4, 4, 1, backends[0]->GetInputs().right);
-        obdPreciseEllipse(&obd, 38, 52, 4, 4, 1, backends[0]->GetInputs().mod_x);
-        obdPreciseEllipse(&obd, 46, 58, 4, 4, 1, backends[0]->GetInputs().mod_y);
-    }else if (leftLayout == "squaresWASD")
-    {
-        obdRectangle(&obd,3,26,9,32,1, backends[0]->GetInputs().l);
-        obdRectangle(&obd,12,20,18,26,1, backends[0]->GetInputs().left);
-        obdRectangle(&obd,22,19,28,25,1, backends[0]->GetInputs().down);
-        obdRectangle(&obd,32,24,38,30,1, backends[0]->GetInputs().right);
-        obdRectangle(&obd,26,10,32,16,1, backends[0]->GetInputs().up);
-        obdRectangle(&obd,35,49,41,55,1, backends[0]->GetInputs().mod_x);
-        obdRectangle(&obd,43,55,49,61,1, backends[0]->GetInputs().mod_y);
-    }else if (leftLayout == "htangl"){
-        obdRectangle(&obd,3,26,9,32,1, backends[0]->GetInputs().l);
-        obdRectangle(&obd,12,20,18,26,1, backends[0]->GetInputs().left);
-        obdRectangle(&obd,22,19,28,25,1, backends[0]->GetInputs().down);
-        obdRectangle(&obd,32,24,38,30,1, backends[0]->GetInputs().right);
-        obdRectangle(&obd,35,49,41,55,1, backends[0]->GetInputs().mod_x);
-        obdRectangle(&obd,41,55,47,61,1, backends[0]->GetInputs().mod_y);
-    };
-    
-    if (centerLayout == "circles")
-    {
-        obdPreciseEllipse(&obd, 64, 27, 4, 4, 1, backends[0]->GetInputs().start);
-    }else if (centerLayout == "circles3Button")
-    {
-        obdPreciseEllipse(&obd, 64, 27, 4, 4, 1, backends[0]->GetInputs().start);
-        obdPreciseEllipse(&obd, 54, 27, 4, 4, 1, backends[0]->GetInputs().select);
-        obdPreciseEllipse(&obd, 74, 27, 4, 4, 1, backends[0]->GetInputs().home);
-    }else if (centerLayout == "squares")
-    {
-        obdRectangle(&obd,61,24,67,30,1, backends[0]->GetInputs().start);
-    }else if (centerLayout == "squares3Button")
-    {
-        obdRectangle(&obd,61,24,67,30,1, backends[0]->GetInputs().start);
-        obdRectangle(&obd,51,24,57,30,1, backends[0]->GetInputs().select);
-        obdRectangle(&obd,71,24,77,30,1, backends[0]->GetInputs().home);
-    }else if (centerLayout == "htangl"){
-        obdRectangle(&obd,50,32,56,38,1, backends[0]->GetInputs().select);
-        obdRectangle(&obd,61,32,67,38,1, backends[0]->GetInputs().start);
-        obdRectangle(&obd,72,32,78,38,1, backends[0]->GetInputs().home);
-    };
-    
-    if (rightLayout == "circles")
-    {
-        obdPreciseEllipse(&obd, 82,  46, 4, 4, 1, backends[0]->GetInputs().c_left);
-        obdPreciseEllipse(&obd, 82,  58, 4, 4, 1, backends[0]->GetInputs().c_down);
-        obdPreciseEllipse(&obd, 90,  40, 4, 4, 1, backends[0]->GetInputs().c_up);
-        obdPreciseEllipse(&obd, 90,  52, 4, 4, 1, backends[0]->GetInputs().a);
-        obdPreciseEllipse(&obd, 98,  46, 4, 4, 1, backends[0]->GetInputs().c_right);
-        obdPreciseEllipse(&obd, 93, 17, 4, 4, 1, backends[0]->GetInputs().r);
-        obdPreciseEllipse(&obd, 93,  27, 4, 4, 1, backends[0]->GetInputs().b);
-        obdPreciseEllipse(&obd, 103, 13, 4, 4, 1, backends[0]->GetInputs().y);
-        obdPreciseEllipse(&obd, 102, 23, 4, 4, 1, backends[0]->GetInputs().x);
-        obdPreciseEllipse(&obd, 113, 14, 4, 4, 1, backends[0]->GetInputs().lightshield);
-        obdPreciseEllipse(&obd, 112, 24, 4, 4, 1, backends[0]->GetInputs().z);
-        obdPreciseEllipse(&obd, 122, 19, 4, 4, 1, backends[0]->GetInputs().midshield);
-        obdPreciseEllipse(&obd, 122, 29, 4, 4, 1, backends[0]->GetInputs().up);
-    }else if (rightLayout == "squares")
-    {
-        obdRectangle(&obd,79,43,85,49,1, backends[0]->GetInputs().c_left);
-        obdRectangle(&obd,79,55,85,61,1, backends[0]->GetInputs().c_down);
-        obdRectangle(&obd,87,37,93,43,1, backends[0]->GetInputs().c_up);
-        obdRectangle(&obd,87,49,93,55,1, backends[0]->GetInputs().a);
-        obdRectangle(&obd,95,43,101,49,1, backends[0]->GetInputs().c_right);
-        obdRectangle(&obd,90,14,96,20,1, backends[0]->GetInputs().r);
-        obdRectangle(&obd,90,24,96,30,1, backends[0]->GetInputs().b);
-        obdRectangle(&obd,100,10,106,16,1, backends[0]->GetInputs().y);
-        obdRectangle(&obd,99,20,105,26,1, backends[0]->GetInputs().x);
-        obdRectangle(&obd,110,11,116,17,1, backends[0]->GetInputs().lightshield);
-        obdRectangle(&obd,109,21,115,27,1, backends[0]->GetInputs().z);
-        obdRectangle(&obd,119,16,125,22,1, backends[0]->GetInputs().midshield);
-        obdRectangle(&obd,119,26,125,32,1, backends[0]->GetInputs().up);
-    }else if (rightLayout == "circles19Button")
-    {
-        obdPreciseEllipse(&obd, 82,  46, 4, 4, 1, backends[0]->GetInputs().c_left);
-        obdPreciseEllipse(&obd, 82,  58, 4, 4, 1, backends[0]->GetInputs().c_down);
-        obdPreciseEllipse(&obd, 90,  40, 4, 4, 1, backends[0]->GetInputs().c_up);
-        obdPreciseEllipse(&obd, 90,  52, 4, 4, 1, backends[0]->GetInputs().a);
-        obdPreciseEllipse(&obd, 98,  46, 4, 4, 1, backends[0]->GetInputs().c_right);
-        obdPreciseEllipse(&obd, 93, 17, 4, 4, 1, backends[0]->GetInputs().r);
-        obdPreciseEllipse(&obd, 93,  27, 4, 4, 1, backends[0]->GetInputs().b);
-        obdPreciseEllipse(&obd, 103, 13, 4, 4, 1, backends[0]->GetInputs().y);
-        obdPreciseEllipse(&obd, 102, 23, 4, 4, 1, backends[0]->GetInputs().x);
-        obdPreciseEllipse(&obd, 113, 14, 4, 4, 1, backends[0]->GetInputs().lightshield);
-        obdPreciseEllipse(&obd, 112, 24, 4, 4, 1, backends[0]->GetInputs().z);
-        obdPreciseEllipse(&obd, 122, 29, 4, 4, 1, backends[0]->GetInputs().up);
-    }else if (rightLayout == "squares19Button")
-    {
-        obdRectangle(&obd,79,43,85,49,1, backends[0]->GetInputs().c_left);
-        obdRectangle(&obd,79,55,85,61,1, backends[0]->GetInputs().c_down);
-        obdRectangle(&obd,87,37,93,43,1, backends[0]->GetInputs().c_up);
-        obdRectangle(&obd,87,49,93,55,1, backends[0]->GetInputs().a);
-        obdRectangle(&obd,95,43,101,49,1, backends[0]->GetInputs().c_right);
-        obdRectangle(&obd,90,14,96,20,1, backends[0]->GetInputs().r);
-        obdRectangle(&obd,90,24,96,30,1, backends[0]->GetInputs().b);
-        obdRectangle(&obd,100,10,106,16,1, backends[0]->GetInputs().y);
-        obdRectangle(&obd,99,20,105,26,1, backends[0]->GetInputs().x);
-        obdRectangle(&obd,110,11,116,17,1, backends[0]->GetInputs().lightshield);
-        obdRectangle(&obd,109,21,115,27,1, backends[0]->GetInputs().z);
-        obdRectangle(&obd,119,26,125,32,1, backends[0]->GetInputs().up);
-    }else if (rightLayout == "htangl"){
-        obdRectangle(&obd,89,23,95,29,1, backends[0]->GetInputs().b);
-        obdRectangle(&obd,99,18,105,24,1, backends[0]->GetInputs().x);
-        obdRectangle(&obd,109,19,115,25,1, backends[0]->GetInputs().z);
-        obdRectangle(&obd,119,26,125,32,1, backends[0]->GetInputs().up);
-        obdRectangle(&obd,89,31,95,37,1, backends[0]->GetInputs().r);
-        obdRectangle(&obd,99,26,105,32,1, backends[0]->GetInputs().y);
-        obdRectangle(&obd,109,27,115,33,1, backends[0]->GetInputs().lightshield);
-        obdRectangle(&obd,119,34,125,40,1, backends[0]->GetInputs().midshield);
-        obdRectangle(&obd,88,40,94,46,1, backends[0]->GetInputs().c_up);
-        obdRectangle(&obd,80,45,86,51,1, backends[0]->GetInputs().c_left);
-        obdRectangle(&obd,80,55,86,61,1, backends[0]->GetInputs().c_down);
-        obdRectangle(&obd,88,49,94,55,1, backends[0]->GetInputs().a);
-        obdRectangle(&obd,96,45,102,51,1, backends[0]->GetInputs().c_right);
-    };
-
-    obdDumpBuffer(&obd,NULL); //Sends buffered content to display.
-}
\ No newline at end of file
+    // Communication backend in the top left, current mode in the top right, and rumble state in
+    // between. Labels are only redrawn when they change.
+    const ModeInfo *mode = backends[0]->GetModeInfo();
+    display->SetLabel(LABEL_LEFT, backends[0]->Info().name);
+    display->SetLabel(LABEL_CENTER, backends[0]->GetFeedback().rumble ? "RUMBLE" : "");
+    display->SetLabel(LABEL_RIGHT, mode != nullptr ? mode->name : "");
+
+    // Redraws the buttons that changed and sends only the changed parts of the screen. On most
+    // displays they are sent in the background, and this returns straight away.
+    if (poll_stats_page != nullptr) {
+        poll_stats_t stats;
+        backends[0]->GetPollStats().Get(stats);
+        poll_stats_page->Update(stats);
+    }
+    if (stick_display != nullptr) {
+        StickSnapshot sticks;
+        backends[0]->GetStickSnapshot(sticks);
+        stick_display->Update(sticks);
+    }
+
+    display->Update(inputs);
+    frame_scheduler->FrameDone(micros());
+}
@@ -10,15 +10,57 @@ enum reportState : byte {
     ReportInvalid = 0x00
 };
 
+enum class InputViewerProtocol {
+    // 25 byte ASCII report understood by the original B0XX input viewer.
+    ASCII,
+    // Compact binary report including analog outputs and a timestamp.
+    BINARY,
+};
+
+#define INPUT_VIEWER_BINARY_HEADER 0xB0
+
+typedef struct __attribute__((packed)) {
+    uint8_t header; // Always INPUT_VIEWER_BINARY_HEADER
+    uint32_t timestamp_us; // Time the report was sent, in microseconds since boot
+    uint32_t buttons; // Input mask as packed by input_mask::pack()
+    uint8_t left_stick_x;
+    uint8_t left_stick_y;
+    uint8_t right_stick_x;
+    uint8_t right_stick_y;
+    uint8_t trigger_l;
+    uint8_t trigger_r;
+    uint8_t checksum; // XOR of all preceding bytes
+} input_viewer_report_t;
+
 class B0XXInputViewer : public CommunicationBackend {
   public:
-    B0XXInputViewer(InputSource **input_sources, size_t input_source_count);
+    static constexpr BackendInfo info = { BackendId::B0XX_INPUT_VIEWER, "B0XX" };
+
+    B0XXInputViewer(
+        InputSource **input_sources,
+        size_t input_source_count,
+        CommunicationBackend *primary_backend = nullptr,
+        InputViewerProtocol protocol = InputViewerProtocol::BINARY,
+        uint32_t min_interval_us = 4000,
+        uint32_t max_interval_us = 100000
+    );
     ~B0XXInputViewer();
     void SendReport();
+    const BackendInfo &Info() { return info; }
 
   private:
+    CommunicationBackend *_primary_backend;
+    InputViewerProtocol _protocol;
+    uint32_t _min_interval_us;
+    uint32_t _max_interval_us;
+    uint32_t _last_report_us = 0;
+
+    uint32_t _last_buttons = 0xFFFFFFFF;
     uint8_t _report[25];
-    uint8_t _clock;
+    input_viewer_report_t _binary_report;
+
+    bool UpdateAsciiReport(uint32_t buttons);
+    bool UpdateBinaryReport(uint32_t buttons, OutputState &outputs);
 };
 
-#endif
\ No newline at end of file
+#endif
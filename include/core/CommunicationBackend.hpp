@@ -3,29 +3,70 @@
 
 #include "core/ControllerMode.hpp"
 #include "core/InputSource.hpp"
+#include "core/PollStats.hpp"
+#include "core/TraceRecorder.hpp"
 #include "state.hpp"
 
+enum class BackendId : uint8_t {
+    GAMECUBE,
+    GAMECUBE_MIRROR,
+    N64,
+    XINPUT,
+    DINPUT,
+    NINTENDO_SWITCH,
+    B0XX_INPUT_VIEWER,
+};
+
+typedef struct {
+    BackendId id;
+    const char *name; // Short name shown on the display
+} BackendInfo;
+
 class CommunicationBackend {
   public:
     CommunicationBackend(InputSource **input_sources, size_t input_source_count);
     virtual ~CommunicationBackend(){};
 
+    // Each backend has a static BackendInfo named info that this returns.
+    virtual const BackendInfo &Info() = 0;
+
     InputState &GetInputs();
+    // Input mask of the last poll's inputs as scanned, before the mode's SOCD handling changed
+    // them.
+    uint32_t GetRawInputs();
+    OutputState &GetOutputs();
+    FeedbackState &GetFeedback();
+    PollStats &GetPollStats();
+    // Stick outputs of the last poll. Safe to call from the other core.
+    void GetStickSnapshot(StickSnapshot &snapshot);
     void ScanInputs();
     void ScanInputs(InputScanSpeed input_source_filter);
 
     void UpdateOutputs();
     virtual void SetGameMode(ControllerMode *gamemode);
+    // The mode in use, which may be a keyboard mode rather than the backend's own game mode. Only
+    // the pointer to the mode's static info is published, so it can be read from the other core
+    // without locking, even while the mode is being replaced.
+    const ModeInfo *GetModeInfo();
+    void SetModeInfo(const ModeInfo *info);
+    void SetTraceRecorder(TraceRecorder *recorder);
 
     virtual void SendReport() = 0;
 
   protected:
     InputState _inputs;
+    uint32_t _raw_inputs = 0;
     InputSource **_input_sources;
     size_t _input_source_count;
 
     OutputState _outputs;
+    FeedbackState _feedback;
     ControllerMode *_gamemode;
+    TraceRecorder *_recorder = nullptr;
+    const ModeInfo *volatile _mode_info = nullptr;
+    // All four stick axes packed into one word, so a reader never sees axes from different polls.
+    volatile uint32_t _stick_snapshot = 0x80808080;
+    PollStats _poll_stats;
 
   private:
     void ResetOutputs();
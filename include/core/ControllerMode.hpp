@@ -5,9 +5,26 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
+// Full deflection of an OEM N64 controller stick.
+#define N64_STICK_RANGE 80
+
+// Stick thresholds read by Super Smash Bros. on the N64, in N64 coordinates. Modes' N64 coordinate
+// tables place their modifier coordinates between these.
+#define N64_SSB_DEADZONE 8       // Anything less is neutral
+#define N64_SSB_SLOW_WALK_MAX 26 // Slowest walk up to here
+#define N64_SSB_JUMP_MIN 53      // Tap jump upwards, crouch and platform drop downwards
+#define N64_SSB_SMASH_MIN 56     // Dash, and smash attacks when reached quickly
+
+// A point on a mode's N64 coordinate table, as distances from neutral.
+typedef struct {
+    uint8_t offset;     // Distance in the mode's own coordinates
+    uint8_t n64_offset; // Distance to send to the N64
+} N64AxisPoint;
+
 class ControllerMode : public InputMode {
   public:
     ControllerMode();
+    ~ControllerMode();
     void UpdateOutputs(InputState &inputs, OutputState &outputs);
     void ResetDirections();
     virtual void UpdateDirections(
@@ -25,10 +42,70 @@ class ControllerMode : public InputMode {
         OutputState &outputs
     );
 
+    /**
+     * Enables conversion of the mode's stick outputs to N64 coordinates. The mode's full deflection,
+     * as passed to UpdateDirections(), maps onto n64_range, and the points given to
+     * SetN64AxisMap() are interpolated linearly in between. Modes without points are scaled
+     * linearly. The result is kept in a table per axis, which is built here by running the mode
+     * once with nothing pressed, so that N64AxisX() and N64AxisY() only need a lookup when
+     * answering a poll.
+     */
+    void InitN64AxisMap(uint8_t n64_range = N64_STICK_RANGE);
+
+    // Gives the mode read access to feedback from the console, such as rumble.
+    void SetFeedbackState(const FeedbackState *feedback);
+
+    // Convert a stick axis value from the OutputState range to the N64 range. Modes that don't
+    // use UpdateDirections() send the raw distance from neutral.
+    inline int8_t N64AxisX(uint8_t value) { return N64Axis(value, 0); }
+    inline int8_t N64AxisY(uint8_t value) { return N64Axis(value, 1); }
+
   protected:
     StickDirections directions;
+    const FeedbackState *_feedback = nullptr;
+
+    /**
+     * Sets the mode's N64 coordinate table for each axis, e.g. to move modifier coordinates tuned
+     * for Melee onto the thresholds of N64 games. Points must be in increasing order and short of
+     * the mode's full deflection. The arrays are not copied.
+     */
+    void SetN64AxisMap(
+        const N64AxisPoint *x_points,
+        size_t x_point_count,
+        const N64AxisPoint *y_points,
+        size_t y_point_count
+    );
 
   private:
+    bool _n64_axis_map_enabled = false;
+    uint8_t _n64_range = N64_STICK_RANGE;
+    const N64AxisPoint *_n64_x_points = nullptr;
+    size_t _n64_x_point_count = 0;
+    const N64AxisPoint *_n64_y_points = nullptr;
+    size_t _n64_y_point_count = 0;
+    uint8_t _n64_stick_range = 0; // Stick range the map was built for
+    uint8_t *_n64_axis_map = nullptr; // X map followed by Y map
+
+    inline int8_t N64Axis(uint8_t value, int axis) {
+        int offset = value - 128;
+        if (_n64_axis_map == nullptr) {
+            return offset;
+        }
+        // Anything beyond the mode's full deflection, e.g. a passed through stick, is clamped.
+        int distance = offset < 0 ? -offset : offset;
+        if (distance > _n64_stick_range) {
+            distance = _n64_stick_range;
+        }
+        int n64_offset = _n64_axis_map[axis * (_n64_stick_range + 1) + distance];
+        return offset < 0 ? -n64_offset : n64_offset;
+    }
+
+    void BuildN64AxisMap(uint8_t stick_range);
+    void FillN64AxisMap(uint8_t *map, const N64AxisPoint *points, size_t point_count);
+
+#ifdef ANALOG_INPUT_STATE
+    void UpdatePassthroughOutputs(InputState &inputs, OutputState &outputs);
+#endif
     virtual void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) = 0;
     virtual void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) = 0;
 };
@@ -4,11 +4,39 @@
 #include "socd.hpp"
 #include "state.hpp"
 
+enum class ModeId : uint8_t {
+    MELEE_20_BUTTON,
+    MELEE_18_BUTTON,
+    PROJECT_M,
+    ULTIMATE,
+    ULTIMATE_2,
+    FGC,
+    RIVALS_OF_AETHER,
+    DARK_SOULS,
+    HOLLOW_KNIGHT,
+    MKWII,
+    MULTIVERSUS,
+    ROCKET_LEAGUE,
+    SALT_AND_SANCTUARY,
+    SHOVEL_KNIGHT,
+    DEFAULT_KEYBOARD,
+    TOUGH_LOVE_ARENA,
+};
+
+typedef struct {
+    ModeId id;
+    const char *name; // Short name shown on the display
+} ModeInfo;
+
 class InputMode {
   public:
     InputMode();
     virtual ~InputMode();
 
+    // Each mode has a static ModeInfo named info that this returns, so the reference stays valid
+    // after the mode is deleted.
+    virtual const ModeInfo &Info() = 0;
+
   protected:
     socd::SocdPair *_socd_pairs = nullptr;
     size_t _socd_pair_count = 0;
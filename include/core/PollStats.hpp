@@ -0,0 +1,63 @@
+#ifndef _CORE_POLLSTATS_HPP
+#define _CORE_POLLSTATS_HPP
+
+#include "stdlib.hpp"
+
+// Length of the window over which poll rate, latency and slack are measured.
+#define POLL_STATS_WINDOW_US 1000000
+
+// Shown in place of a measurement when there were no samples for it in the last window.
+#define POLL_STATS_NO_SAMPLES 0xFFFFFFFF
+
+typedef struct {
+    uint32_t poll_rate; // Polls answered in the last window
+    uint32_t min_latency_us; // Time from the poll being detected to the reply being sent
+    uint32_t max_latency_us;
+    uint32_t min_slack_us; // Smallest time the report was ready before the reply was due
+    uint32_t skipped_polls; // Polls that couldn't be answered since boot
+} poll_stats_t;
+
+/**
+ * Counts polls from the host and measures how quickly they are answered. Backends call the event
+ * functions from their SendReport(), which only costs a few comparisons per poll. Every
+ * POLL_STATS_WINDOW_US the measurements for the window are published, and they can then be read
+ * from the other core with Get().
+ *
+ * Slack is only measured by backends that call ReportReady(), i.e. ones where the reply is due at a
+ * fixed time after the poll.
+ */
+class PollStats {
+  public:
+    void PollStarted();
+    void ReportReady();
+    void ReplySent();
+    void PollSkipped();
+
+    void Get(poll_stats_t &stats);
+    // True if no poll has started in the last idle_us. Safe to call from the other core.
+    bool Idle(uint32_t idle_us);
+
+  private:
+    volatile uint32_t _window_start_us = 0;
+    volatile uint32_t _poll_start_us = 0;
+    uint32_t _ready_us = 0;
+    bool _ready = false;
+
+    // Measurements for the window in progress.
+    uint32_t _poll_count = 0;
+    uint32_t _min_latency_us = POLL_STATS_NO_SAMPLES;
+    uint32_t _max_latency_us = 0;
+    uint32_t _min_slack_us = POLL_STATS_NO_SAMPLES;
+
+    volatile poll_stats_t _published = {
+        0,
+        POLL_STATS_NO_SAMPLES,
+        POLL_STATS_NO_SAMPLES,
+        POLL_STATS_NO_SAMPLES,
+        0,
+    };
+
+    void Publish(uint32_t now_us);
+};
+
+#endif
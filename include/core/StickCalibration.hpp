@@ -0,0 +1,70 @@
+#ifndef _CORE_STICKCALIBRATION_HPP
+#define _CORE_STICKCALIBRATION_HPP
+
+#include "stdlib.hpp"
+
+// Largest distance from center of a calibrated stick axis.
+#define STICK_CALIBRATION_RANGE 127
+
+// Size of the radial lookup table, which is indexed by squared distance from center >> 4.
+#define STICK_CALIBRATION_RADIAL_SHIFT 4
+#define STICK_CALIBRATION_RADIAL_SIZE                                                              \
+    ((2 * STICK_CALIBRATION_RANGE * STICK_CALIBRATION_RANGE >> STICK_CALIBRATION_RADIAL_SHIFT) + 1)
+
+typedef struct {
+    // Raw readings, where 128 is the nominal center.
+    uint8_t center_x = 128;
+    uint8_t center_y = 128;
+    uint8_t min_x = 28;
+    uint8_t max_x = 228;
+    uint8_t min_y = 28;
+    uint8_t max_y = 228;
+    // Radial dead-zone and anti-deadzone, in calibrated units out of STICK_CALIBRATION_RANGE.
+    uint8_t deadzone = 8;
+    uint8_t anti_deadzone = 0;
+    // Response curve exponent in tenths, i.e. 10 is linear.
+    uint8_t curve = 10;
+} stick_calibration_t;
+
+/**
+ * Calibrates a raw analog stick, e.g. a Nunchuk stick. The calibration parameters are compiled
+ * into per-axis normalization tables and a radial response table when they are set, so that
+ * applying the calibration only costs three table reads per poll.
+ */
+class StickCalibration {
+  public:
+    StickCalibration(const stick_calibration_t &params = stick_calibration_t());
+    ~StickCalibration();
+
+    void SetParams(const stick_calibration_t &params);
+    const stick_calibration_t &GetParams();
+
+    // Calibrates a raw stick position in place. Values are centered on 128 before and after.
+    void Apply(uint8_t &x, uint8_t &y);
+
+    // Capturing records center and range from raw samples. The center is taken from the first
+    // sample, so the stick must be at rest when capture starts.
+    void StartCapture();
+    void CaptureSample(uint8_t x, uint8_t y);
+    void FinishCapture();
+    bool Capturing();
+
+    // Response curve mapping a normalized distance from center to the calibrated distance.
+    static float Response(float distance, const stick_calibration_t &params);
+
+  private:
+    stick_calibration_t _params;
+    stick_calibration_t _capture;
+    bool _capturing = false;
+    bool _capture_started = false;
+
+    int8_t _axis_x[256];
+    int8_t _axis_y[256];
+    uint16_t *_radial = nullptr; // Q8 scale factor per squared distance
+
+    void Compile();
+    static int Clamp(int value);
+    static void CompileAxis(int8_t *table, uint8_t center, uint8_t min, uint8_t max);
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef _CORE_TRACERECORDER_HPP
+#define _CORE_TRACERECORDER_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+#define TRACE_FRAME_HEADER 0xB1
+
+// Bit positions of each digital output in a recorded output mask.
+typedef enum {
+    OUTPUT_BIT_A,
+    OUTPUT_BIT_B,
+    OUTPUT_BIT_X,
+    OUTPUT_BIT_Y,
+    OUTPUT_BIT_BUTTON_L,
+    OUTPUT_BIT_BUTTON_R,
+    OUTPUT_BIT_TRIGGER_L_DIGITAL,
+    OUTPUT_BIT_TRIGGER_R_DIGITAL,
+    OUTPUT_BIT_START,
+    OUTPUT_BIT_SELECT,
+    OUTPUT_BIT_HOME,
+    OUTPUT_BIT_DPAD_UP,
+    OUTPUT_BIT_DPAD_DOWN,
+    OUTPUT_BIT_DPAD_LEFT,
+    OUTPUT_BIT_DPAD_RIGHT,
+    OUTPUT_BIT_LEFT_STICK_CLICK,
+    OUTPUT_BIT_RIGHT_STICK_CLICK,
+    OUTPUT_BIT_COUNT,
+} OutputBit;
+
+typedef struct __attribute__((packed)) {
+    uint16_t sequence; // Incremented for every poll, including ones that were dropped
+    uint32_t timestamp_us; // Time the outputs were computed, in microseconds since boot
+    uint32_t inputs; // Input mask as packed by input_mask::pack(), before SOCD resolution
+    int8_t nunchuk_x;
+    int8_t nunchuk_y;
+    uint32_t outputs; // Digital outputs mask, indexed by OutputBit
+    uint8_t left_stick_x;
+    uint8_t left_stick_y;
+    uint8_t right_stick_x;
+    uint8_t right_stick_y;
+    uint8_t trigger_l_analog;
+    uint8_t trigger_r_analog;
+    // The rest is recorded at rest in builds without ANALOG_INPUT_STATE, so the format is the same.
+    uint16_t passthrough; // Passthrough mask as packed by input_mask::pack_passthrough()
+    uint8_t analog_stick_x; // Analog inputs, as they were in the InputState
+    uint8_t analog_stick_y;
+    uint8_t analog_cstick_x;
+    uint8_t analog_cstick_y;
+    uint8_t analog_trigger_l;
+    uint8_t analog_trigger_r;
+} trace_record_t;
+
+/**
+ * Records the scanned inputs and resulting outputs of every poll into a ring buffer, and streams
+ * them out over serial whenever there is spare time. Each record is sent as a frame consisting of
+ * TRACE_FRAME_HEADER, the trace_record_t and an XOR checksum of the record bytes.
+ *
+ * Record() never waits. If the buffer is full, the record is dropped and shows up as a gap in the
+ * sequence numbers. Record() and Drain() may run on different cores.
+ */
+class TraceRecorder {
+  public:
+    TraceRecorder(uint capacity_log2 = 7);
+    ~TraceRecorder();
+
+    void Record(uint32_t raw_inputs, const InputState &inputs, const OutputState &outputs);
+    void Drain(size_t max_records = 4);
+    uint32_t Dropped();
+
+    // Restores the recorded inputs, both digital and analog, as they were before SOCD resolution.
+    static void UnpackInputs(const trace_record_t &record, InputState &inputs);
+    static void UnpackOutputs(const trace_record_t &record, OutputState &outputs);
+
+  private:
+    trace_record_t *_records;
+    uint32_t _mask;
+    volatile uint32_t _head = 0;
+    volatile uint32_t _tail = 0;
+    uint16_t _sequence = 0;
+    uint32_t _dropped = 0;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _CORE_ANALOG_HPP
+#define _CORE_ANALOG_HPP
+
+#include "stdlib.hpp"
+
+namespace analog {
+    typedef struct {
+        // Raw readings when released and fully pressed. Released can be higher than pressed, for
+        // sensors whose reading drops as they are pressed.
+        uint16_t raw_released;
+        uint16_t raw_pressed;
+        // Output values below this are reported as 0, to hide noise around the released position.
+        uint8_t deadzone = 0;
+    } ChannelCalibration;
+
+    /**
+     * Averages the last sample_count samples of one channel in a buffer of interleaved samples,
+     * where sample i belongs to channel i % channel_count.
+     */
+    uint16_t average(
+        const volatile uint16_t *samples,
+        size_t channel_count,
+        size_t sample_count,
+        size_t channel
+    );
+
+    // Converts a raw reading to a value from 0 (released) to 255 (fully pressed).
+    uint8_t calibrate(uint16_t raw, const ChannelCalibration &calibration);
+}
+
+#endif
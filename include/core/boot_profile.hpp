@@ -0,0 +1,42 @@
+#ifndef _CORE_BOOT_PROFILE_HPP
+#define _CORE_BOOT_PROFILE_HPP
+
+#include "stdlib.hpp"
+
+#define BOOT_PROFILE_FRAME_HEADER 0xB2
+
+// Timestamp sent for stages that haven't been marked.
+#define BOOT_PROFILE_NOT_MARKED 0xFFFFFFFF
+
+namespace boot_profile {
+    typedef enum {
+        STAGE_INPUT_INIT,
+        STAGE_CONSOLE_DETECT,
+        STAGE_BACKEND_INIT,
+        STAGE_MODE_INIT, // Last step of setup()
+        STAGE_FIRST_REPORT,
+        STAGE_NUNCHUK_INIT,
+        STAGE_DISPLAY_INIT,
+        STAGE_COUNT,
+    } Stage;
+
+    typedef struct __attribute__((packed)) {
+        uint8_t stage_count; // Always STAGE_COUNT
+        uint32_t timestamps_us[STAGE_COUNT]; // Microseconds since reset, indexed by Stage
+    } boot_profile_record_t;
+
+    // Records the time at which a boot stage finished. Only the first call for each stage counts,
+    // so it is safe to call from the main loop. Each stage has its own slot, so stages may be
+    // marked from either core.
+    void mark(Stage stage);
+
+    /**
+     * Sends the recorded stage timestamps over serial as a single frame: BOOT_PROFILE_FRAME_HEADER,
+     * the boot_profile_record_t and an XOR checksum of the record bytes. The framing matches the
+     * poll trace, so tools/decode_trace.py skips it, and it is only sent if it fits in the serial
+     * buffer in one go. Returns true once it was sent.
+     */
+    bool send();
+}
+
+#endif
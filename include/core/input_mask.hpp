@@ -0,0 +1,75 @@
+#ifndef _CORE_INPUT_MASK_HPP
+#define _CORE_INPUT_MASK_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+namespace input_mask {
+    // Bit positions of each digital input in a packed input mask. The order follows the field
+    // order of InputState, and must not be changed as it is part of the serial protocols.
+    typedef enum {
+        BIT_LEFT,
+        BIT_RIGHT,
+        BIT_DOWN,
+        BIT_UP,
+        BIT_C_LEFT,
+        BIT_C_RIGHT,
+        BIT_C_DOWN,
+        BIT_C_UP,
+        BIT_A,
+        BIT_B,
+        BIT_X,
+        BIT_Y,
+        BIT_L,
+        BIT_R,
+        BIT_Z,
+        BIT_LIGHTSHIELD,
+        BIT_MIDSHIELD,
+        BIT_SELECT,
+        BIT_START,
+        BIT_HOME,
+        BIT_MOD_X,
+        BIT_MOD_Y,
+        BIT_NUNCHUK_CONNECTED,
+        BIT_NUNCHUK_C,
+        BIT_NUNCHUK_Z,
+        BIT_COUNT,
+    } InputBit;
+
+#ifdef ANALOG_INPUT_STATE
+    // Bit positions of each GameCube controller passthrough button in a packed passthrough mask.
+    // These don't fit in the 32-bit input mask alongside InputBit, so they get a mask of their own.
+    // The order must not be changed as it is part of the trace format.
+    typedef enum {
+        GCC_BIT_CONNECTED,
+        GCC_BIT_A,
+        GCC_BIT_B,
+        GCC_BIT_X,
+        GCC_BIT_Y,
+        GCC_BIT_Z,
+        GCC_BIT_L,
+        GCC_BIT_R,
+        GCC_BIT_START,
+        GCC_BIT_DPAD_UP,
+        GCC_BIT_DPAD_DOWN,
+        GCC_BIT_DPAD_LEFT,
+        GCC_BIT_DPAD_RIGHT,
+        GCC_BIT_COUNT,
+    } PassthroughBit;
+#endif
+
+    uint32_t pack(const InputState &inputs);
+
+    void unpack(uint32_t mask, InputState &inputs);
+
+#ifdef ANALOG_INPUT_STATE
+    uint16_t pack_passthrough(const InputState &inputs);
+
+    void unpack_passthrough(uint16_t mask, InputState &inputs);
+#endif
+
+    // Returns the InputState field for a bit, or nullptr if the bit is out of range.
+    bool InputState::*member(uint8_t bit);
+}
+
+#endif
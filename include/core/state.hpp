@@ -35,6 +35,34 @@ typedef struct inputstate {
     int8_t nunchuk_y = 0;
     bool nunchuk_c = false;
     bool nunchuk_z = false;
+
+    // Only the Pico has input sources for the fields below, so other builds leave them out to keep
+    // InputState small.
+#ifdef ANALOG_INPUT_STATE
+    // Analog inputs, e.g. from a GameCube controller being passed through. Sticks are centered on
+    // 128.
+    uint8_t analog_stick_x = 128;
+    uint8_t analog_stick_y = 128;
+    uint8_t analog_cstick_x = 128;
+    uint8_t analog_cstick_y = 128;
+    uint8_t analog_trigger_l = 0;
+    uint8_t analog_trigger_r = 0;
+
+    // GameCube controller passthrough buttons.
+    bool gcc_connected = false;
+    bool gcc_a = false;
+    bool gcc_b = false;
+    bool gcc_x = false;
+    bool gcc_y = false;
+    bool gcc_z = false;
+    bool gcc_l = false;
+    bool gcc_r = false;
+    bool gcc_start = false;
+    bool gcc_dpad_up = false;
+    bool gcc_dpad_down = false;
+    bool gcc_dpad_left = false;
+    bool gcc_dpad_right = false;
+#endif
 } InputState;
 
 // State describing stick direction at the quadrant level.
@@ -78,4 +106,17 @@ typedef struct outputstate {
     uint8_t triggerLAnalog = 0;
 } OutputState;
 
+// Stick outputs of a single poll, in the same range as OutputState.
+typedef struct {
+    uint8_t left_x;
+    uint8_t left_y;
+    uint8_t right_x;
+    uint8_t right_y;
+} StickSnapshot;
+
+// Feedback received from the host/console.
+typedef struct feedbackstate {
+    bool rumble = false;
+} FeedbackState;
+
 #endif
\ No newline at end of file
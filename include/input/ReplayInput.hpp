@@ -0,0 +1,44 @@
+#ifndef _INPUT_REPLAYINPUT_HPP
+#define _INPUT_REPLAYINPUT_HPP
+
+#include "core/InputSource.hpp"
+#include "core/TraceRecorder.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+/**
+ * Feeds inputs from a recorded trace (as produced by TraceRecorder) into a backend, so that any
+ * mode can be run against real recorded input sequences.
+ *
+ * By default every call to UpdateInputs() advances to the next record, which makes replays
+ * deterministic and lets them run as fast as the backend can go. In realtime mode, records are
+ * instead played back according to their timestamps.
+ */
+class ReplayInput : public InputSource {
+  public:
+    ReplayInput(
+        const trace_record_t *records,
+        size_t record_count,
+        bool realtime = false,
+        bool loop = false
+    );
+    InputScanSpeed ScanSpeed();
+    void UpdateInputs(InputState &inputs);
+
+    void Restart();
+    bool Finished();
+    const trace_record_t *CurrentRecord();
+    void ExpectedOutputs(OutputState &outputs);
+
+  protected:
+    const trace_record_t *_records;
+    size_t _record_count;
+    bool _realtime;
+    bool _loop;
+
+    size_t _index = 0;
+    bool _started = false;
+    uint32_t _start_us = 0;
+};
+
+#endif
@@ -7,7 +7,10 @@
 
 class DefaultKeyboardMode : public KeyboardMode {
   public:
+    static constexpr ModeInfo info = { ModeId::DEFAULT_KEYBOARD, "KB" };
+
     DefaultKeyboardMode(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateKeys(InputState &inputs);
@@ -7,7 +7,10 @@
 
 class FgcMode : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::FGC, "FGC" };
+
     FgcMode(socd::SocdType horizontal_socd, socd::SocdType vertical_socd);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
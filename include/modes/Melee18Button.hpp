@@ -11,7 +11,10 @@ typedef struct {
 
 class Melee18Button : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::MELEE_18_BUTTON, "MELEE18" };
+
     Melee18Button(socd::SocdType socd_type, Melee18ButtonOptions options = {});
+    const ModeInfo &Info() { return info; }
 
   private:
     Melee18ButtonOptions _options;
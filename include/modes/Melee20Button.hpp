@@ -11,7 +11,10 @@ typedef struct {
 
 class Melee20Button : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::MELEE_20_BUTTON, "MELEE" };
+
     Melee20Button(socd::SocdType socd_type, Melee20ButtonOptions options = {});
+    const ModeInfo &Info() { return info; }
 
   protected:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
@@ -12,7 +12,10 @@ typedef struct {
 
 class ProjectM : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::PROJECT_M, "PM" };
+
     ProjectM(socd::SocdType socd_type, ProjectMOptions options = {});
+    const ModeInfo &Info() { return info; }
 
   private:
     ProjectMOptions _options;
@@ -7,7 +7,10 @@
 
 class RivalsOfAether : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::RIVALS_OF_AETHER, "RoA" };
+
     RivalsOfAether(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
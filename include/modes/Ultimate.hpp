@@ -7,7 +7,10 @@
 
 class Ultimate : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::ULTIMATE, "ULT" };
+
     Ultimate(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
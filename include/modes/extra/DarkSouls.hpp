@@ -7,7 +7,10 @@
 
 class DarkSouls : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::DARK_SOULS, "DS" };
+
     DarkSouls(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
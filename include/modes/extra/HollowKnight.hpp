@@ -8,7 +8,10 @@
 
 class HollowKnight : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::HOLLOW_KNIGHT, "HK" };
+
     HollowKnight(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
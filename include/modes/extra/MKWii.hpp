@@ -7,7 +7,10 @@
 
 class MKWii : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::MKWII, "MKWII" };
+
     MKWii(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
@@ -7,7 +7,10 @@
 
 class MultiVersus : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::MULTIVERSUS, "MVS" };
+
     MultiVersus(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   protected:
     virtual void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
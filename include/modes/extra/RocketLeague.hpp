@@ -7,10 +7,12 @@
 
 class RocketLeague : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::ROCKET_LEAGUE, "RL" };
+
     RocketLeague(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
-    void HandleSocd(InputState &inputs);
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
     void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
 };
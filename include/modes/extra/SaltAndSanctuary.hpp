@@ -7,7 +7,10 @@
 
 class SaltAndSanctuary : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::SALT_AND_SANCTUARY, "SnS" };
+
     SaltAndSanctuary(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
@@ -7,7 +7,10 @@
 
 class ShovelKnight : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::SHOVEL_KNIGHT, "SK" };
+
     ShovelKnight(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     virtual void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
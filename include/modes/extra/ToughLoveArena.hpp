@@ -7,7 +7,10 @@
 
 class ToughLoveArena : public KeyboardMode {
   public:
+    static constexpr ModeInfo info = { ModeId::TOUGH_LOVE_ARENA, "TLA" };
+
     ToughLoveArena(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateKeys(InputState &inputs);
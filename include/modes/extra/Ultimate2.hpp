@@ -1,5 +1,5 @@
-#ifndef _MODES_ULTIMATE_HPP
-#define _MODES_ULTIMATE_HPP
+#ifndef _MODES_ULTIMATE2_HPP
+#define _MODES_ULTIMATE2_HPP
 
 #include "core/ControllerMode.hpp"
 #include "core/socd.hpp"
@@ -7,7 +7,10 @@
 
 class Ultimate2 : public ControllerMode {
   public:
+    static constexpr ModeInfo info = { ModeId::ULTIMATE_2, "ULT2" };
+
     Ultimate2(socd::SocdType socd_type);
+    const ModeInfo &Info() { return info; }
 
   private:
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
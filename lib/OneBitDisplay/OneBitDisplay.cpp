@@ -238,17 +238,21 @@ void obdSPIInit(OBDISP *pOBD, int iType, int iDC, int iCS, int iReset, int iMOSI
 	pOBD->wrap = 0;           // default - disable text wrap
 	pOBD->com_mode = COM_SPI; // communication mode
 
+	gpio_init(pOBD->iCSPin);
 	gpio_set_dir(pOBD->iCSPin, true);
 	gpio_put(pOBD->iCSPin, 0); //(pOBD->type < SHARP_144x168)); // set to not-active
 
 	if (pOBD->iDCPin != 0xff) // Note - not needed on Sharp Memory LCDs
 	{
+		gpio_init(pOBD->iDCPin);
 		gpio_set_dir(pOBD->iDCPin, true);
 		gpio_put(pOBD->iDCPin, 0); // for some reason, command mode must be set or some OLEDs/LCDs won't initialize correctly even if set later
 	}
 
 	if (bBitBang)
 	{
+		gpio_init(iMOSI);
+		gpio_init(iCLK);
 		gpio_set_dir(iMOSI, true);
 		gpio_set_dir(iCLK, true);
 	}
@@ -256,6 +260,7 @@ void obdSPIInit(OBDISP *pOBD, int iType, int iDC, int iCS, int iReset, int iMOSI
 	// Reset it
 	if (iReset != -1)
 	{
+		gpio_init(iReset);
 		gpio_set_dir(iReset, true);
 		gpio_put(iReset, LOW);
 		sleep_ms(100);
@@ -265,17 +270,18 @@ void obdSPIInit(OBDISP *pOBD, int iType, int iDC, int iCS, int iReset, int iMOSI
 
 	if (iLED != -1)
 	{
+		gpio_init(iLED);
 		gpio_set_dir(iLED, true);
 	}
 
 	// Initialize SPI
 	if (!bBitBang)
 	{
-		pOBD->iMOSIPin = 0xff; // mark it as hardware SPI
 		gpio_set_function(pOBD->iCLKPin, GPIO_FUNC_SPI);
 		gpio_set_function(pOBD->iMOSIPin, GPIO_FUNC_SPI);
+		pOBD->iMOSIPin = 0xff; // mark it as hardware SPI
 
-		spi_init(pOBD->bbi2c.picoSPI, 1000 * 1000);
+		spi_init(pOBD->bbi2c.picoSPI, iSpeed);
 		spi_set_format(pOBD->bbi2c.picoSPI, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
 	}
 
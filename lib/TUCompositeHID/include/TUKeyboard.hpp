@@ -5,24 +5,42 @@
 #include <Arduino.h>
 #include <TUCompositeHID.hpp>
 
+// Keycodes below the modifier range (0x00-0xDF) each get one bit in the NKRO report.
+#define NKRO_KEYCODE_COUNT 0xE0
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t modifier; // Modifier keys bitmask
+    uint8_t keys[NKRO_KEYCODE_COUNT / 8]; // Bitmap of currently pressed keys
+} nkro_keyboard_report_t;
+
 class TUKeyboard {
   public:
     TUKeyboard();
 
-    static void registerDescriptor();
+    static void registerDescriptor(bool nkro = true);
 
     void begin();
+    bool isPressed(uint8_t keycode);
     void setPressed(uint8_t keycode, bool pressed);
     void press(uint8_t keycode);
     void release(uint8_t keycode);
     void releaseAll();
-    void sendState();
+    bool pending();
+    bool sendState();
+    void flush();
 
   private:
     static const uint8_t _report_id = 2;
     static uint8_t _descriptor[];
+    static uint8_t _nkro_descriptor[];
+    static bool _nkro;
 
-    hid_keyboard_report_t _report;
+    // The bitmap is always kept up to date so key lookups are constant time. The 6KRO report is
+    // only maintained when the 6KRO descriptor was registered.
+    nkro_keyboard_report_t _nkro_report = {};
+    nkro_keyboard_report_t _sent_nkro_report = {};
+    hid_keyboard_report_t _report = {};
+    hid_keyboard_report_t _sent_report = {};
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,15 +2,57 @@
 
 #include <Adafruit_TinyUSB.h>
 #include <TUCompositeHID.hpp>
+#include <string.h>
+
+// clang-format off
+
+#define HID_REPORT_DESC_NKRO(...) \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     )                 ,\
+    HID_USAGE      ( HID_USAGE_DESKTOP_KEYBOARD )                 ,\
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION )                 ,\
+        /* Report ID if any */\
+        __VA_ARGS__ \
+        /* 8 bit Modifier Keys (Shift, Control, Alt) */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_KEYBOARD                ) ,\
+        HID_USAGE_MIN      ( 224                                    ) ,\
+        HID_USAGE_MAX      ( 231                                    ) ,\
+        HID_LOGICAL_MIN    ( 0                                      ) ,\
+        HID_LOGICAL_MAX    ( 1                                      ) ,\
+        HID_REPORT_COUNT   ( 8                                      ) ,\
+        HID_REPORT_SIZE    ( 1                                      ) ,\
+        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        /* 224 bit Keycode Bitmap */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_KEYBOARD                ) ,\
+        HID_USAGE_MIN      ( 0                                      ) ,\
+        HID_USAGE_MAX      ( NKRO_KEYCODE_COUNT - 1                 ) ,\
+        HID_LOGICAL_MIN    ( 0                                      ) ,\
+        HID_LOGICAL_MAX    ( 1                                      ) ,\
+        HID_REPORT_COUNT   ( NKRO_KEYCODE_COUNT                     ) ,\
+        HID_REPORT_SIZE    ( 1                                      ) ,\
+        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+    HID_COLLECTION_END
+
+// clang-format on
 
 uint8_t TUKeyboard::_descriptor[] = { TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(_report_id)) };
+uint8_t TUKeyboard::_nkro_descriptor[] = { HID_REPORT_DESC_NKRO(HID_REPORT_ID(_report_id)) };
+bool TUKeyboard::_nkro = false;
 
 #define MODIFIER_MASK(mod_kc) (1 << (mod_kc & 0x0F))
+#define KEY_INDEX(kc) (kc >> 3)
+#define KEY_MASK(kc) (1 << (kc & 0x07))
 
 TUKeyboard::TUKeyboard() {}
 
-void TUKeyboard::registerDescriptor() {
-    TUCompositeHID::addDescriptor(_descriptor, sizeof(_descriptor));
+void TUKeyboard::registerDescriptor(bool nkro) {
+    // The report format can't change after enumeration, so every TUKeyboard instance uses
+    // whichever descriptor was registered here.
+    _nkro = nkro;
+    if (nkro) {
+        TUCompositeHID::addDescriptor(_nkro_descriptor, sizeof(_nkro_descriptor));
+    } else {
+        TUCompositeHID::addDescriptor(_descriptor, sizeof(_descriptor));
+    }
 }
 
 void TUKeyboard::begin() {
@@ -18,31 +60,40 @@ void TUKeyboard::begin() {
     releaseAll();
 }
 
+bool TUKeyboard::isPressed(uint8_t keycode) {
+    if (keycode >= 0xE0) {
+        return _nkro_report.modifier & MODIFIER_MASK(keycode);
+    }
+    return _nkro_report.keys[KEY_INDEX(keycode)] & KEY_MASK(keycode);
+}
+
 void TUKeyboard::press(uint8_t keycode) {
     // If keycode >= E0 then it's a modifier key.
     if (keycode >= 0xE0) {
         // Create bitmask from the modifier keycode to set the corresponding bit in the modifier
         // byte.
         uint8_t bitmask = MODIFIER_MASK(keycode);
+        _nkro_report.modifier |= bitmask;
         _report.modifier |= bitmask;
         return;
     }
 
-    // Check if the key is already pressed so that we don't send the same keycode multiple times in
-    // the same report.
-    for (int i = 0; i < 6; i++) {
-        if (_report.keycode[i] == keycode) {
-            return;
-        }
+    // Keys that are already held (or HID_KEY_NONE) don't change the report.
+    if (keycode == HID_KEY_NONE || isPressed(keycode)) {
+        return;
     }
 
-    // Place this keycode in the report in place of the first empty keycode.
-    for (int i = 0; i < 6; i++) {
-        if (_report.keycode[i] == HID_KEY_NONE) {
-            _report.keycode[i] = keycode;
+    if (!_nkro) {
+        // Place this keycode in the report in place of the first empty keycode. If all 6 slots are
+        // taken the key is left unpressed so that it gets retried on the next report.
+        uint8_t *slot = (uint8_t *)memchr(_report.keycode, HID_KEY_NONE, 6);
+        if (slot == nullptr) {
             return;
         }
+        *slot = keycode;
     }
+
+    _nkro_report.keys[KEY_INDEX(keycode)] |= KEY_MASK(keycode);
 }
 
 void TUKeyboard::release(uint8_t keycode) {
@@ -51,14 +102,21 @@ void TUKeyboard::release(uint8_t keycode) {
         // Create bitmask from the modifier keycode to unset the corresponding bit in the modifier
         // byte.
         uint8_t bitmask = ~MODIFIER_MASK(keycode);
+        _nkro_report.modifier &= bitmask;
         _report.modifier &= bitmask;
         return;
     }
 
-    // Loop through keycodes in report. If we find the specified key code, we clear it.
-    for (int i = 0; i < 6; i++) {
-        if (_report.keycode[i] == keycode) {
-            _report.keycode[i] = HID_KEY_NONE;
+    if (!isPressed(keycode)) {
+        return;
+    }
+
+    _nkro_report.keys[KEY_INDEX(keycode)] &= ~KEY_MASK(keycode);
+
+    if (!_nkro) {
+        uint8_t *slot = (uint8_t *)memchr(_report.keycode, keycode, 6);
+        if (slot != nullptr) {
+            *slot = HID_KEY_NONE;
         }
     }
 }
@@ -72,15 +130,48 @@ void TUKeyboard::setPressed(uint8_t keycode, bool pressed) {
 }
 
 void TUKeyboard::releaseAll() {
-    for (int i = 0; i < 6; i++) {
-        _report.keycode[i] = 0;
+    _nkro_report = {};
+    _report = {};
+}
+
+bool TUKeyboard::pending() {
+    if (_nkro) {
+        return memcmp(&_nkro_report, &_sent_nkro_report, sizeof(nkro_keyboard_report_t)) != 0;
     }
-    _report.modifier = 0;
+    return memcmp(&_report, &_sent_report, sizeof(hid_keyboard_report_t)) != 0;
 }
 
-void TUKeyboard::sendState() {
-    while (!TUCompositeHID::_usb_hid.ready()) {
+bool TUKeyboard::sendState() {
+    // Nothing to do if the host already has the current key state.
+    if (!pending()) {
+        return true;
+    }
+
+    // Never wait for the endpoint. If the host hasn't taken the previous report yet, the current
+    // state stays pending and gets coalesced with any further changes until the next call.
+    if (!TUCompositeHID::_usb_hid.ready()) {
+        return false;
+    }
+
+    bool sent;
+    if (_nkro) {
+        sent = TUCompositeHID::_usb_hid
+                   .sendReport(_report_id, &_nkro_report, sizeof(nkro_keyboard_report_t));
+    } else {
+        sent = TUCompositeHID::_usb_hid
+                   .sendReport(_report_id, &_report, sizeof(hid_keyboard_report_t));
+    }
+    if (!sent) {
+        return false;
+    }
+
+    _sent_nkro_report = _nkro_report;
+    _sent_report = _report;
+    return true;
+}
+
+void TUKeyboard::flush() {
+    while (!sendState()) {
         tight_loop_contents();
     }
-    TUCompositeHID::_usb_hid.sendReport(_report_id, &_report, sizeof(hid_keyboard_report_t));
-}
\ No newline at end of file
+}
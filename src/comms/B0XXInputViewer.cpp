@@ -1,12 +1,33 @@
 #include "comms/B0XXInputViewer.hpp"
 
 #include "core/InputSource.hpp"
+#include "core/input_mask.hpp"
 #include "serial.hpp"
 
+#include <stddef.h>
+#include <string.h>
+
 #define ASCII_BIT(x) (x ? '1' : '0');
 
-B0XXInputViewer::B0XXInputViewer(InputSource **input_sources, size_t input_source_count)
+B0XXInputViewer::B0XXInputViewer(
+    InputSource **input_sources,
+    size_t input_source_count,
+    CommunicationBackend *primary_backend,
+    InputViewerProtocol protocol,
+    uint32_t min_interval_us,
+    uint32_t max_interval_us
+)
     : CommunicationBackend(input_sources, input_source_count) {
+    _primary_backend = primary_backend;
+    _protocol = protocol;
+    _min_interval_us = min_interval_us;
+    _max_interval_us = max_interval_us;
+
+    _binary_report = {};
+    _binary_report.header = INPUT_VIEWER_BINARY_HEADER;
+    // Guarantees that the first report is seen as a change.
+    _binary_report.buttons = 0xFFFFFFFF;
+
     serial::init(115200);
 }
 
@@ -15,47 +36,107 @@ B0XXInputViewer::~B0XXInputViewer() {
 }
 
 void B0XXInputViewer::SendReport() {
-    if (serial::available_for_write() < 32) {
+    // Reports are rate limited by wall clock time rather than loop iterations, because the main
+    // loop runs at very different rates depending on the primary backend.
+    uint32_t now = micros();
+    uint32_t elapsed = now - _last_report_us;
+    if (elapsed < _min_interval_us || serial::available_for_write() < 32) {
+        return;
+    }
+
+    if (_primary_backend == nullptr) {
+        // Only scan fast input sources because we don't want to waste any more time than necessary
+        // on the input viewer and we can't afford to read from something like a Nunchuk twice.
+        ScanInputs(InputScanSpeed::FAST);
+    }
+
+    // Reuse the state the primary backend just scanned and computed if we have one. Its inputs
+    // have been through the mode's SOCD handling by now, so take the copy it kept from before that
+    // to show what is actually being held.
+    uint32_t buttons = _primary_backend != nullptr ? _primary_backend->GetRawInputs()
+                                                   : input_mask::pack(_inputs);
+    OutputState &outputs = _primary_backend != nullptr ? _primary_backend->GetOutputs() : _outputs;
+
+    bool changed = _protocol == InputViewerProtocol::ASCII ? UpdateAsciiReport(buttons)
+                                                            : UpdateBinaryReport(buttons, outputs);
+
+    // While the state isn't changing, drop down to a slow keepalive rate.
+    if (!changed && elapsed < _max_interval_us) {
         return;
     }
+    _last_report_us = now;
 
-    // Report clock is used to limit input viewer reports to being sent only once every 5
-    // increments.
-    if (_clock < 5) {
-        _clock++;
+    if (_protocol == InputViewerProtocol::ASCII) {
+        serial::write(_report, sizeof(_report));
         return;
     }
-    _clock = 0;
-
-    // Only scan fast input sources because we don't want to waste any more time than necessary
-    // on the input viewer and we can't afford to read from something like a Nunchuk twice.
-    ScanInputs(InputScanSpeed::FAST);
-
-    _report[0] = ASCII_BIT(_inputs.start);
-    _report[1] = ASCII_BIT(_inputs.y);
-    _report[2] = ASCII_BIT(_inputs.x);
-    _report[3] = ASCII_BIT(_inputs.b);
-    _report[4] = ASCII_BIT(_inputs.a);
-    _report[5] = ASCII_BIT(_inputs.l);
-    _report[6] = ASCII_BIT(_inputs.r);
-    _report[7] = ASCII_BIT(_inputs.z);
-    _report[8] = ASCII_BIT(_inputs.up);
-    _report[9] = ASCII_BIT(_inputs.down);
-    _report[10] = ASCII_BIT(_inputs.right);
-    _report[11] = ASCII_BIT(_inputs.left);
-    _report[12] = ASCII_BIT(_inputs.mod_x);
-    _report[13] = ASCII_BIT(_inputs.mod_y);
-    _report[14] = ASCII_BIT(_inputs.c_left);
-    _report[15] = ASCII_BIT(_inputs.c_right);
-    _report[16] = ASCII_BIT(_inputs.c_up);
-    _report[17] = ASCII_BIT(_inputs.c_down);
-    _report[18] = ASCII_BIT(_inputs.lightshield);
-    _report[19] = ASCII_BIT(_inputs.midshield);
+
+    _binary_report.timestamp_us = now;
+    uint8_t *bytes = (uint8_t *)&_binary_report;
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < offsetof(input_viewer_report_t, checksum); i++) {
+        checksum ^= bytes[i];
+    }
+    _binary_report.checksum = checksum;
+
+    serial::write(bytes, sizeof(input_viewer_report_t));
+}
+
+bool B0XXInputViewer::UpdateAsciiReport(uint32_t buttons) {
+    if (buttons == _last_buttons) {
+        return false;
+    }
+    _last_buttons = buttons;
+
+    InputState inputs;
+    input_mask::unpack(buttons, inputs);
+
+    _report[0] = ASCII_BIT(inputs.start);
+    _report[1] = ASCII_BIT(inputs.y);
+    _report[2] = ASCII_BIT(inputs.x);
+    _report[3] = ASCII_BIT(inputs.b);
+    _report[4] = ASCII_BIT(inputs.a);
+    _report[5] = ASCII_BIT(inputs.l);
+    _report[6] = ASCII_BIT(inputs.r);
+    _report[7] = ASCII_BIT(inputs.z);
+    _report[8] = ASCII_BIT(inputs.up);
+    _report[9] = ASCII_BIT(inputs.down);
+    _report[10] = ASCII_BIT(inputs.right);
+    _report[11] = ASCII_BIT(inputs.left);
+    _report[12] = ASCII_BIT(inputs.mod_x);
+    _report[13] = ASCII_BIT(inputs.mod_y);
+    _report[14] = ASCII_BIT(inputs.c_left);
+    _report[15] = ASCII_BIT(inputs.c_right);
+    _report[16] = ASCII_BIT(inputs.c_up);
+    _report[17] = ASCII_BIT(inputs.c_down);
+    _report[18] = ASCII_BIT(inputs.lightshield);
+    _report[19] = ASCII_BIT(inputs.midshield);
     _report[20] = ASCII_BIT(false);
     _report[21] = ASCII_BIT(false);
     _report[22] = ASCII_BIT(false);
     _report[23] = ASCII_BIT(true);
     _report[24] = '\n';
 
-    serial::write(_report, 25);
-}
\ No newline at end of file
+    return true;
+}
+
+bool B0XXInputViewer::UpdateBinaryReport(uint32_t buttons, OutputState &outputs) {
+    input_viewer_report_t report = _binary_report;
+    report.buttons = buttons;
+    report.left_stick_x = outputs.leftStickX;
+    report.left_stick_y = outputs.leftStickY;
+    report.right_stick_x = outputs.rightStickX;
+    report.right_stick_y = outputs.rightStickY;
+    report.trigger_l = outputs.triggerLDigital ? 255 : outputs.triggerLAnalog;
+    report.trigger_r = outputs.triggerRDigital ? 255 : outputs.triggerRAnalog;
+
+    // Compare everything between the timestamp and the checksum.
+    size_t start = offsetof(input_viewer_report_t, buttons);
+    size_t end = offsetof(input_viewer_report_t, checksum);
+    uint8_t *new_bytes = (uint8_t *)&report;
+    uint8_t *old_bytes = (uint8_t *)&_binary_report;
+    bool changed = memcmp(new_bytes + start, old_bytes + start, end - start) != 0;
+
+    _binary_report = report;
+    return changed;
+}
@@ -2,6 +2,9 @@
 
 #include "core/ControllerMode.hpp"
 #include "core/InputSource.hpp"
+#include "core/PollStats.hpp"
+#include "core/TraceRecorder.hpp"
+#include "core/input_mask.hpp"
 #include "core/state.hpp"
 
 CommunicationBackend::CommunicationBackend(InputSource **input_sources, size_t input_source_count) {
@@ -14,6 +17,30 @@ InputState &CommunicationBackend::GetInputs() {
     return _inputs;
 }
 
+uint32_t CommunicationBackend::GetRawInputs() {
+    return _raw_inputs;
+}
+
+OutputState &CommunicationBackend::GetOutputs() {
+    return _outputs;
+}
+
+FeedbackState &CommunicationBackend::GetFeedback() {
+    return _feedback;
+}
+
+PollStats &CommunicationBackend::GetPollStats() {
+    return _poll_stats;
+}
+
+void CommunicationBackend::GetStickSnapshot(StickSnapshot &snapshot) {
+    uint32_t packed = _stick_snapshot;
+    snapshot.left_x = packed;
+    snapshot.left_y = packed >> 8;
+    snapshot.right_x = packed >> 16;
+    snapshot.right_y = packed >> 24;
+}
+
 void CommunicationBackend::ScanInputs() {
     for (size_t i = 0; i < _input_source_count; i++) {
         _input_sources[i]->UpdateInputs(_inputs);
@@ -35,12 +62,40 @@ void CommunicationBackend::ResetOutputs() {
 
 void CommunicationBackend::UpdateOutputs() {
     ResetOutputs();
+
+    // Capture the raw inputs before the mode's SOCD handling modifies them.
+    _raw_inputs = input_mask::pack(_inputs);
+
     if (_gamemode != nullptr) {
         _gamemode->UpdateOutputs(_inputs, _outputs);
     }
+
+    if (_recorder != nullptr) {
+        _recorder->Record(_raw_inputs, _inputs, _outputs);
+    }
+
+    _stick_snapshot = (uint32_t)_outputs.leftStickX | ((uint32_t)_outputs.leftStickY << 8) |
+                      ((uint32_t)_outputs.rightStickX << 16) |
+                      ((uint32_t)_outputs.rightStickY << 24);
 }
 
 void CommunicationBackend::SetGameMode(ControllerMode *gamemode) {
     delete _gamemode;
     _gamemode = gamemode;
+    if (_gamemode != nullptr) {
+        _gamemode->SetFeedbackState(&_feedback);
+    }
+    SetModeInfo(_gamemode != nullptr ? &_gamemode->Info() : nullptr);
+}
+
+const ModeInfo *CommunicationBackend::GetModeInfo() {
+    return _mode_info;
+}
+
+void CommunicationBackend::SetModeInfo(const ModeInfo *info) {
+    _mode_info = info;
+}
+
+void CommunicationBackend::SetTraceRecorder(TraceRecorder *recorder) {
+    _recorder = recorder;
 }
@@ -5,12 +5,58 @@ ControllerMode::ControllerMode() {
     ResetDirections();
 }
 
+ControllerMode::~ControllerMode() {
+    delete[] _n64_axis_map;
+}
+
 void ControllerMode::UpdateOutputs(InputState &inputs, OutputState &outputs) {
     HandleSocd(inputs);
     UpdateDigitalOutputs(inputs, outputs);
     UpdateAnalogOutputs(inputs, outputs);
+#ifdef ANALOG_INPUT_STATE
+    if (inputs.gcc_connected) {
+        UpdatePassthroughOutputs(inputs, outputs);
+    }
+
+    // Analog triggers, e.g. from a passed through controller or Hall-effect sensors, are combined
+    // with the mode's trigger outputs. Whichever is pressed further wins.
+    if (inputs.analog_trigger_l > outputs.triggerLAnalog) {
+        outputs.triggerLAnalog = inputs.analog_trigger_l;
+    }
+    if (inputs.analog_trigger_r > outputs.triggerRAnalog) {
+        outputs.triggerRAnalog = inputs.analog_trigger_r;
+    }
+#endif
 }
 
+#ifdef ANALOG_INPUT_STATE
+void ControllerMode::UpdatePassthroughOutputs(InputState &inputs, OutputState &outputs) {
+    // The control stick is already passed through by modes' Nunchuk stick handling. Buttons are
+    // combined with the mode's outputs, so both controllers can be used at the same time.
+    outputs.a |= inputs.gcc_a;
+    outputs.b |= inputs.gcc_b;
+    outputs.x |= inputs.gcc_x;
+    outputs.y |= inputs.gcc_y;
+    outputs.buttonR |= inputs.gcc_z;
+    outputs.triggerLDigital |= inputs.gcc_l;
+    outputs.triggerRDigital |= inputs.gcc_r;
+    outputs.start |= inputs.gcc_start;
+    outputs.dpadUp |= inputs.gcc_dpad_up;
+    outputs.dpadDown |= inputs.gcc_dpad_down;
+    outputs.dpadLeft |= inputs.gcc_dpad_left;
+    outputs.dpadRight |= inputs.gcc_dpad_right;
+
+    // The C-stick takes over when it is moved out of its dead-zone.
+    const uint8_t cstick_min = 128 - 16;
+    const uint8_t cstick_max = 128 + 16;
+    if (inputs.analog_cstick_x < cstick_min || inputs.analog_cstick_x > cstick_max ||
+        inputs.analog_cstick_y < cstick_min || inputs.analog_cstick_y > cstick_max) {
+        outputs.rightStickX = inputs.analog_cstick_x;
+        outputs.rightStickY = inputs.analog_cstick_y;
+    }
+}
+#endif
+
 void ControllerMode::ResetDirections() {
     directions = {
         .horizontal = false,
@@ -39,6 +85,11 @@ void ControllerMode::UpdateDirections(
 ) {
     ResetDirections();
 
+    uint8_t stick_range = analogStickMax - analogStickNeutral;
+    if (_n64_axis_map_enabled && stick_range != _n64_stick_range && stick_range > 0) {
+        BuildN64AxisMap(stick_range);
+    }
+
     outputs.leftStickX = analogStickNeutral;
     outputs.leftStickY = analogStickNeutral;
     outputs.rightStickX = analogStickNeutral;
@@ -87,3 +138,70 @@ void ControllerMode::UpdateDirections(
         }
     }
 }
+
+void ControllerMode::SetFeedbackState(const FeedbackState *feedback) {
+    _feedback = feedback;
+}
+
+void ControllerMode::SetN64AxisMap(
+    const N64AxisPoint *x_points,
+    size_t x_point_count,
+    const N64AxisPoint *y_points,
+    size_t y_point_count
+) {
+    _n64_x_points = x_points;
+    _n64_x_point_count = x_point_count;
+    _n64_y_points = y_points;
+    _n64_y_point_count = y_point_count;
+}
+
+void ControllerMode::InitN64AxisMap(uint8_t n64_range) {
+    _n64_axis_map_enabled = true;
+    _n64_range = n64_range;
+
+    // Modes report their stick range through UpdateDirections(), which builds the map.
+    delete[] _n64_axis_map;
+    _n64_axis_map = nullptr;
+    _n64_stick_range = 0;
+    InputState inputs;
+    OutputState outputs;
+    UpdateOutputs(inputs, outputs);
+}
+
+void ControllerMode::BuildN64AxisMap(uint8_t stick_range) {
+    // Each map only covers one side of the axis up to full deflection, and is mirrored for the
+    // other.
+    delete[] _n64_axis_map;
+    _n64_axis_map = new uint8_t[2 * (stick_range + 1)];
+    _n64_stick_range = stick_range;
+
+    FillN64AxisMap(_n64_axis_map, _n64_x_points, _n64_x_point_count);
+    FillN64AxisMap(_n64_axis_map + stick_range + 1, _n64_y_points, _n64_y_point_count);
+}
+
+void ControllerMode::FillN64AxisMap(uint8_t *map, const N64AxisPoint *points, size_t point_count) {
+    // Interpolate linearly between the points around each offset, rounding to nearest. Neutral and
+    // full deflection are implicit points.
+    for (int offset = 0; offset <= _n64_stick_range; offset++) {
+        int from = 0;
+        int from_n64 = 0;
+        int to = _n64_stick_range;
+        int to_n64 = _n64_range;
+        for (size_t i = 0; i < point_count; i++) {
+            if (points[i].offset > offset) {
+                to = points[i].offset;
+                to_n64 = points[i].n64_offset;
+                break;
+            }
+            from = points[i].offset;
+            from_n64 = points[i].n64_offset;
+        }
+
+        int n64_offset = from_n64;
+        if (to > from) {
+            int span = to - from;
+            n64_offset += ((offset - from) * (to_n64 - from_n64) * 2 + span) / (span * 2);
+        }
+        map[offset] = n64_offset > _n64_range ? _n64_range : n64_offset;
+    }
+}
@@ -0,0 +1,79 @@
+#include "core/PollStats.hpp"
+
+void PollStats::PollStarted() {
+    _poll_start_us = micros();
+    _ready = false;
+}
+
+void PollStats::ReportReady() {
+    _ready_us = micros();
+    _ready = true;
+}
+
+void PollStats::ReplySent() {
+    uint32_t now_us = micros();
+
+    uint32_t latency_us = now_us - _poll_start_us;
+    if (latency_us < _min_latency_us) {
+        _min_latency_us = latency_us;
+    }
+    if (latency_us > _max_latency_us) {
+        _max_latency_us = latency_us;
+    }
+
+    if (_ready) {
+        uint32_t slack_us = now_us - _ready_us;
+        if (slack_us < _min_slack_us) {
+            _min_slack_us = slack_us;
+        }
+    }
+
+    _poll_count++;
+    if (now_us - _window_start_us >= POLL_STATS_WINDOW_US) {
+        Publish(now_us);
+    }
+}
+
+void PollStats::PollSkipped() {
+    _published.skipped_polls = _published.skipped_polls + 1;
+}
+
+void PollStats::Publish(uint32_t now_us) {
+    // The fields are only written here, on the core running the backend, and each is a single
+    // word, so a reader on the other core sees at worst a mix of this window's and the last one's.
+    _published.poll_rate =
+        (uint64_t)_poll_count * POLL_STATS_WINDOW_US / (now_us - _window_start_us);
+    _published.min_latency_us = _min_latency_us;
+    _published.max_latency_us = _max_latency_us;
+    _published.min_slack_us = _min_slack_us;
+
+    _window_start_us = now_us;
+    _poll_count = 0;
+    _min_latency_us = POLL_STATS_NO_SAMPLES;
+    _max_latency_us = 0;
+    _min_slack_us = POLL_STATS_NO_SAMPLES;
+}
+
+void PollStats::Get(poll_stats_t &stats) {
+    stats.skipped_polls = _published.skipped_polls;
+
+    // Windows are only published when a poll is answered, so if there haven't been any for a while
+    // the last published window is out of date.
+    uint32_t window_start_us = _window_start_us;
+    if (micros() - window_start_us > 2 * POLL_STATS_WINDOW_US) {
+        stats.poll_rate = 0;
+        stats.min_latency_us = POLL_STATS_NO_SAMPLES;
+        stats.max_latency_us = POLL_STATS_NO_SAMPLES;
+        stats.min_slack_us = POLL_STATS_NO_SAMPLES;
+        return;
+    }
+
+    stats.poll_rate = _published.poll_rate;
+    stats.min_latency_us = _published.min_latency_us;
+    stats.max_latency_us = _published.max_latency_us;
+    stats.min_slack_us = _published.min_slack_us;
+}
+
+bool PollStats::Idle(uint32_t idle_us) {
+    return micros() - _poll_start_us >= idle_us;
+}
@@ -0,0 +1,120 @@
+#include "core/StickCalibration.hpp"
+
+#include <math.h>
+
+StickCalibration::StickCalibration(const stick_calibration_t &params) {
+    _radial = new uint16_t[STICK_CALIBRATION_RADIAL_SIZE];
+    SetParams(params);
+}
+
+StickCalibration::~StickCalibration() {
+    delete[] _radial;
+}
+
+void StickCalibration::SetParams(const stick_calibration_t &params) {
+    _params = params;
+    Compile();
+}
+
+const stick_calibration_t &StickCalibration::GetParams() {
+    return _params;
+}
+
+void StickCalibration::Apply(uint8_t &x, uint8_t &y) {
+    int cal_x = _axis_x[x];
+    int cal_y = _axis_y[y];
+    uint16_t scale = _radial[(cal_x * cal_x + cal_y * cal_y) >> STICK_CALIBRATION_RADIAL_SHIFT];
+
+    x = 128 + Clamp((cal_x * scale) >> 8);
+    y = 128 + Clamp((cal_y * scale) >> 8);
+}
+
+int StickCalibration::Clamp(int value) {
+    // Entries of the radial table are shared by a range of distances, so the result can slightly
+    // overshoot the range.
+    if (value > STICK_CALIBRATION_RANGE) {
+        return STICK_CALIBRATION_RANGE;
+    }
+    if (value < -STICK_CALIBRATION_RANGE) {
+        return -STICK_CALIBRATION_RANGE;
+    }
+    return value;
+}
+
+void StickCalibration::StartCapture() {
+    _capturing = true;
+    _capture_started = false;
+}
+
+void StickCalibration::CaptureSample(uint8_t x, uint8_t y) {
+    if (!_capturing) {
+        return;
+    }
+
+    if (!_capture_started) {
+        // Keep the response settings and start the range out from the resting position.
+        _capture = _params;
+        _capture.center_x = _capture.min_x = _capture.max_x = x;
+        _capture.center_y = _capture.min_y = _capture.max_y = y;
+        _capture_started = true;
+        return;
+    }
+
+    _capture.min_x = x < _capture.min_x ? x : _capture.min_x;
+    _capture.max_x = x > _capture.max_x ? x : _capture.max_x;
+    _capture.min_y = y < _capture.min_y ? y : _capture.min_y;
+    _capture.max_y = y > _capture.max_y ? y : _capture.max_y;
+}
+
+void StickCalibration::FinishCapture() {
+    if (_capturing && _capture_started) {
+        SetParams(_capture);
+    }
+    _capturing = false;
+}
+
+bool StickCalibration::Capturing() {
+    return _capturing;
+}
+
+float StickCalibration::Response(float distance, const stick_calibration_t &params) {
+    const float range = STICK_CALIBRATION_RANGE;
+    float deadzone = params.deadzone < range ? params.deadzone : range - 1;
+    if (distance <= deadzone) {
+        return 0;
+    }
+
+    float t = (distance - deadzone) / (range - deadzone);
+    if (t > 1) {
+        t = 1;
+    }
+    if (params.curve != 10 && params.curve != 0) {
+        t = powf(t, params.curve / 10.0f);
+    }
+
+    float anti_deadzone = params.anti_deadzone < range ? params.anti_deadzone : range;
+    return anti_deadzone + t * (range - anti_deadzone);
+}
+
+void StickCalibration::CompileAxis(int8_t *table, uint8_t center, uint8_t min, uint8_t max) {
+    for (int raw = 0; raw < 256; raw++) {
+        int offset = raw - center;
+        // Scale each side of center separately, because sticks are rarely symmetrical.
+        int span = offset >= 0 ? max - center : center - min;
+        table[raw] = Clamp(span > 0 ? offset * STICK_CALIBRATION_RANGE / span : 0);
+    }
+}
+
+void StickCalibration::Compile() {
+    CompileAxis(_axis_x, _params.center_x, _params.min_x, _params.max_x);
+    CompileAxis(_axis_y, _params.center_y, _params.min_y, _params.max_y);
+
+    for (size_t i = 0; i < STICK_CALIBRATION_RADIAL_SIZE; i++) {
+        // Use the middle of the range of squared distances that share this entry.
+        float distance = sqrtf((i << STICK_CALIBRATION_RADIAL_SHIFT) +
+                               (1 << (STICK_CALIBRATION_RADIAL_SHIFT - 1)));
+        float scale = Response(distance, _params) / distance;
+        // Round rather than truncate, or full deflection would come out one short of the range.
+        _radial[i] = (uint16_t)(scale * 256 + 0.5f);
+    }
+}
@@ -0,0 +1,154 @@
+#include "core/TraceRecorder.hpp"
+
+#include "core/input_mask.hpp"
+#include "core/state.hpp"
+#include "serial.hpp"
+
+#include <string.h>
+
+// Indexed by OutputBit.
+static bool OutputState::*const output_bits[OUTPUT_BIT_COUNT] = {
+    &OutputState::a,
+    &OutputState::b,
+    &OutputState::x,
+    &OutputState::y,
+    &OutputState::buttonL,
+    &OutputState::buttonR,
+    &OutputState::triggerLDigital,
+    &OutputState::triggerRDigital,
+    &OutputState::start,
+    &OutputState::select,
+    &OutputState::home,
+    &OutputState::dpadUp,
+    &OutputState::dpadDown,
+    &OutputState::dpadLeft,
+    &OutputState::dpadRight,
+    &OutputState::leftStickClick,
+    &OutputState::rightStickClick,
+};
+
+TraceRecorder::TraceRecorder(uint capacity_log2) {
+    uint32_t capacity = (uint32_t)1 << capacity_log2;
+    _records = new trace_record_t[capacity];
+    _mask = capacity - 1;
+
+    serial::init(115200);
+}
+
+TraceRecorder::~TraceRecorder() {
+    serial::close();
+    delete[] _records;
+}
+
+void TraceRecorder::Record(
+    uint32_t raw_inputs,
+    const InputState &inputs,
+    const OutputState &outputs
+) {
+    uint16_t sequence = _sequence++;
+
+    uint32_t head = _head;
+    if (head - _tail > _mask) {
+        _dropped++;
+        return;
+    }
+
+    trace_record_t &record = _records[head & _mask];
+    record.sequence = sequence;
+    record.timestamp_us = micros();
+    record.inputs = raw_inputs;
+    record.nunchuk_x = inputs.nunchuk_x;
+    record.nunchuk_y = inputs.nunchuk_y;
+    record.outputs = 0;
+    for (size_t i = 0; i < OUTPUT_BIT_COUNT; i++) {
+        if (outputs.*(output_bits[i])) {
+            record.outputs |= (uint32_t)1 << i;
+        }
+    }
+    record.left_stick_x = outputs.leftStickX;
+    record.left_stick_y = outputs.leftStickY;
+    record.right_stick_x = outputs.rightStickX;
+    record.right_stick_y = outputs.rightStickY;
+    record.trigger_l_analog = outputs.triggerLAnalog;
+    record.trigger_r_analog = outputs.triggerRAnalog;
+#ifdef ANALOG_INPUT_STATE
+    // SOCD resolution only touches digital inputs, so these are still as they were scanned.
+    record.passthrough = input_mask::pack_passthrough(inputs);
+    record.analog_stick_x = inputs.analog_stick_x;
+    record.analog_stick_y = inputs.analog_stick_y;
+    record.analog_cstick_x = inputs.analog_cstick_x;
+    record.analog_cstick_y = inputs.analog_cstick_y;
+    record.analog_trigger_l = inputs.analog_trigger_l;
+    record.analog_trigger_r = inputs.analog_trigger_r;
+#else
+    // The trace format stays the same, with these always at rest.
+    record.passthrough = 0;
+    record.analog_stick_x = 128;
+    record.analog_stick_y = 128;
+    record.analog_cstick_x = 128;
+    record.analog_cstick_y = 128;
+    record.analog_trigger_l = 0;
+    record.analog_trigger_r = 0;
+#endif
+
+    // Make sure the record is fully written before it is published to the reader.
+    __sync_synchronize();
+    _head = head + 1;
+}
+
+void TraceRecorder::Drain(size_t max_records) {
+    uint8_t frame[sizeof(trace_record_t) + 2];
+
+    for (size_t i = 0; i < max_records; i++) {
+        uint32_t tail = _tail;
+        if (tail == _head || serial::available_for_write() < (int)sizeof(frame)) {
+            return;
+        }
+        __sync_synchronize();
+
+        frame[0] = TRACE_FRAME_HEADER;
+        memcpy(&frame[1], &_records[tail & _mask], sizeof(trace_record_t));
+        uint8_t checksum = 0;
+        for (size_t j = 1; j < sizeof(frame) - 1; j++) {
+            checksum ^= frame[j];
+        }
+        frame[sizeof(frame) - 1] = checksum;
+
+        // Free up the slot before the (comparatively slow) serial write.
+        __sync_synchronize();
+        _tail = tail + 1;
+
+        serial::write(frame, sizeof(frame));
+    }
+}
+
+uint32_t TraceRecorder::Dropped() {
+    return _dropped;
+}
+
+void TraceRecorder::UnpackInputs(const trace_record_t &record, InputState &inputs) {
+    input_mask::unpack(record.inputs, inputs);
+    inputs.nunchuk_x = record.nunchuk_x;
+    inputs.nunchuk_y = record.nunchuk_y;
+#ifdef ANALOG_INPUT_STATE
+    input_mask::unpack_passthrough(record.passthrough, inputs);
+    inputs.analog_stick_x = record.analog_stick_x;
+    inputs.analog_stick_y = record.analog_stick_y;
+    inputs.analog_cstick_x = record.analog_cstick_x;
+    inputs.analog_cstick_y = record.analog_cstick_y;
+    inputs.analog_trigger_l = record.analog_trigger_l;
+    inputs.analog_trigger_r = record.analog_trigger_r;
+#endif
+}
+
+void TraceRecorder::UnpackOutputs(const trace_record_t &record, OutputState &outputs) {
+    for (size_t i = 0; i < OUTPUT_BIT_COUNT; i++) {
+        outputs.*(output_bits[i]) = (record.outputs >> i) & 1;
+    }
+    outputs.leftStickX = record.left_stick_x;
+    outputs.leftStickY = record.left_stick_y;
+    outputs.rightStickX = record.right_stick_x;
+    outputs.rightStickY = record.right_stick_y;
+    outputs.triggerLAnalog = record.trigger_l_analog;
+    outputs.triggerRAnalog = record.trigger_r_analog;
+}
@@ -0,0 +1,32 @@
+#include "core/analog.hpp"
+
+namespace analog {
+    uint16_t average(
+        const volatile uint16_t *samples,
+        size_t channel_count,
+        size_t sample_count,
+        size_t channel
+    ) {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < sample_count; i++) {
+            sum += samples[i * channel_count + channel];
+        }
+        return (sum + sample_count / 2) / sample_count;
+    }
+
+    uint8_t calibrate(uint16_t raw, const ChannelCalibration &calibration) {
+        int32_t travel = (int32_t)calibration.raw_pressed - calibration.raw_released;
+        if (travel == 0) {
+            return 0;
+        }
+
+        int32_t value = ((int32_t)raw - calibration.raw_released) * 255 / travel;
+        if (value < calibration.deadzone) {
+            return 0;
+        }
+        if (value > 255) {
+            return 255;
+        }
+        return value;
+    }
+}
@@ -0,0 +1,42 @@
+#include "core/boot_profile.hpp"
+
+#include "serial.hpp"
+
+#include <string.h>
+
+namespace boot_profile {
+    static volatile uint32_t timestamps[STAGE_COUNT] = {};
+    static volatile bool marked[STAGE_COUNT] = {};
+
+    void mark(Stage stage) {
+        if (marked[stage]) {
+            return;
+        }
+        timestamps[stage] = micros();
+        marked[stage] = true;
+    }
+
+    bool send() {
+        uint8_t frame[sizeof(boot_profile_record_t) + 2];
+        if (serial::available_for_write() < (int)sizeof(frame)) {
+            return false;
+        }
+
+        boot_profile_record_t record;
+        record.stage_count = STAGE_COUNT;
+        for (size_t i = 0; i < STAGE_COUNT; i++) {
+            record.timestamps_us[i] = marked[i] ? timestamps[i] : BOOT_PROFILE_NOT_MARKED;
+        }
+
+        frame[0] = BOOT_PROFILE_FRAME_HEADER;
+        memcpy(&frame[1], &record, sizeof(record));
+        uint8_t checksum = 0;
+        for (size_t i = 1; i < sizeof(frame) - 1; i++) {
+            checksum ^= frame[i];
+        }
+        frame[sizeof(frame) - 1] = checksum;
+
+        serial::write(frame, sizeof(frame));
+        return true;
+    }
+}
@@ -0,0 +1,91 @@
+#include "core/input_mask.hpp"
+
+#include "core/state.hpp"
+
+namespace input_mask {
+    // Indexed by InputBit.
+    static bool InputState::*const bits[BIT_COUNT] = {
+        &InputState::left,
+        &InputState::right,
+        &InputState::down,
+        &InputState::up,
+        &InputState::c_left,
+        &InputState::c_right,
+        &InputState::c_down,
+        &InputState::c_up,
+        &InputState::a,
+        &InputState::b,
+        &InputState::x,
+        &InputState::y,
+        &InputState::l,
+        &InputState::r,
+        &InputState::z,
+        &InputState::lightshield,
+        &InputState::midshield,
+        &InputState::select,
+        &InputState::start,
+        &InputState::home,
+        &InputState::mod_x,
+        &InputState::mod_y,
+        &InputState::nunchuk_connected,
+        &InputState::nunchuk_c,
+        &InputState::nunchuk_z,
+    };
+
+#ifdef ANALOG_INPUT_STATE
+    // Indexed by PassthroughBit.
+    static bool InputState::*const passthrough_bits[GCC_BIT_COUNT] = {
+        &InputState::gcc_connected,
+        &InputState::gcc_a,
+        &InputState::gcc_b,
+        &InputState::gcc_x,
+        &InputState::gcc_y,
+        &InputState::gcc_z,
+        &InputState::gcc_l,
+        &InputState::gcc_r,
+        &InputState::gcc_start,
+        &InputState::gcc_dpad_up,
+        &InputState::gcc_dpad_down,
+        &InputState::gcc_dpad_left,
+        &InputState::gcc_dpad_right,
+    };
+#endif
+
+    uint32_t pack(const InputState &inputs) {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < BIT_COUNT; i++) {
+            if (inputs.*(bits[i])) {
+                mask |= (uint32_t)1 << i;
+            }
+        }
+        return mask;
+    }
+
+    void unpack(uint32_t mask, InputState &inputs) {
+        for (size_t i = 0; i < BIT_COUNT; i++) {
+            inputs.*(bits[i]) = (mask >> i) & 1;
+        }
+    }
+
+#ifdef ANALOG_INPUT_STATE
+    uint16_t pack_passthrough(const InputState &inputs) {
+        uint16_t mask = 0;
+        for (size_t i = 0; i < GCC_BIT_COUNT; i++) {
+            if (inputs.*(passthrough_bits[i])) {
+                mask |= (uint16_t)1 << i;
+            }
+        }
+        return mask;
+    }
+
+    void unpack_passthrough(uint16_t mask, InputState &inputs) {
+        for (size_t i = 0; i < GCC_BIT_COUNT; i++) {
+            inputs.*(passthrough_bits[i]) = (mask >> i) & 1;
+        }
+    }
+#endif
+
+    bool InputState::*member(uint8_t bit) {
+        return bit < BIT_COUNT ? bits[bit] : nullptr;
+    }
+}
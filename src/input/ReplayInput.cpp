@@ -0,0 +1,66 @@
+#include "input/ReplayInput.hpp"
+
+#include "core/TraceRecorder.hpp"
+
+ReplayInput::ReplayInput(
+    const trace_record_t *records,
+    size_t record_count,
+    bool realtime,
+    bool loop
+) {
+    _records = records;
+    _record_count = record_count;
+    _realtime = realtime;
+    _loop = loop;
+}
+
+InputScanSpeed ReplayInput::ScanSpeed() {
+    return InputScanSpeed::FAST;
+}
+
+void ReplayInput::UpdateInputs(InputState &inputs) {
+    if (_record_count == 0) {
+        return;
+    }
+
+    if (!_started) {
+        _started = true;
+        _start_us = micros();
+    } else if (_index + 1 >= _record_count) {
+        // The last record has already been played, so either start over or keep holding it.
+        if (_loop) {
+            _index = 0;
+            _start_us = micros();
+        }
+    } else if (_realtime) {
+        // Skip ahead to the latest record whose time has come.
+        uint32_t elapsed = micros() - _start_us;
+        while (_index + 1 < _record_count &&
+               _records[_index + 1].timestamp_us - _records[0].timestamp_us <= elapsed) {
+            _index++;
+        }
+    } else {
+        _index++;
+    }
+
+    TraceRecorder::UnpackInputs(_records[_index], inputs);
+}
+
+void ReplayInput::Restart() {
+    _index = 0;
+    _started = false;
+}
+
+bool ReplayInput::Finished() {
+    return _record_count == 0 || (_started && _index + 1 >= _record_count);
+}
+
+const trace_record_t *ReplayInput::CurrentRecord() {
+    return _record_count == 0 ? nullptr : &_records[_index];
+}
+
+void ReplayInput::ExpectedOutputs(OutputState &outputs) {
+    if (_record_count > 0) {
+        TraceRecorder::UnpackOutputs(_records[_index], outputs);
+    }
+}
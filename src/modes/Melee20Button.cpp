@@ -4,6 +4,19 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 208
 
+// Melee's coordinates moved onto the N64 Smash thresholds. Mod Y horizontal is a slow walk and
+// Mod X horizontal a walk short of a dash, while the full diagonals dash. Mod X vertical stays
+// short of a jump or crouch, while Mod Y vertical and the full diagonals reach it.
+static const N64AxisPoint n64_x_points[] = {
+    {27, 18},
+    { 53, 44},
+    { 56, 60},
+};
+static const N64AxisPoint n64_y_points[] = {
+    {43, 36},
+    { 55, 58},
+};
+
 Melee20Button::Melee20Button(socd::SocdType socd_type, Melee20ButtonOptions options) {
     _socd_pair_count = 4;
     _socd_pairs = new socd::SocdPair[_socd_pair_count]{
@@ -12,6 +25,12 @@ Melee20Button::Melee20Button(socd::SocdType socd_type, Melee20ButtonOptions opti
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
     };
+    SetN64AxisMap(
+        n64_x_points,
+        sizeof(n64_x_points) / sizeof(N64AxisPoint),
+        n64_y_points,
+        sizeof(n64_y_points) / sizeof(N64AxisPoint)
+    );
 
     _options = options;
     _horizontal_socd = false;
@@ -4,6 +4,18 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 228
 
+// PM's coordinates moved onto the N64 Smash thresholds. Mod Y horizontal is a slow walk and Mod X
+// horizontal a walk short of a dash. Mod X vertical stays short of a jump or crouch, while Mod Y
+// vertical reaches it.
+static const N64AxisPoint n64_x_points[] = {
+    {35, 20},
+    { 70, 44},
+};
+static const N64AxisPoint n64_y_points[] = {
+    {60, 36},
+    { 70, 60},
+};
+
 ProjectM::ProjectM(socd::SocdType socd_type, ProjectMOptions options) {
     _socd_pair_count = 4;
     _socd_pairs = new socd::SocdPair[_socd_pair_count]{
@@ -12,6 +24,12 @@ ProjectM::ProjectM(socd::SocdType socd_type, ProjectMOptions options) {
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
     };
+    SetN64AxisMap(
+        n64_x_points,
+        sizeof(n64_x_points) / sizeof(N64AxisPoint),
+        n64_y_points,
+        sizeof(n64_y_points) / sizeof(N64AxisPoint)
+    );
 
     _options = options;
     _horizontal_socd = false;
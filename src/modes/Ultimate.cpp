@@ -5,6 +5,18 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 228
 
+// Ultimate's coordinates moved onto the N64 Smash thresholds. Mod Y horizontal is a slow walk
+// and Mod X horizontal a walk short of a dash. Both vertical modifiers stay short of a jump or
+// crouch.
+static const N64AxisPoint n64_x_points[] = {
+    {41, 20},
+    { 53, 44},
+};
+static const N64AxisPoint n64_y_points[] = {
+    {44, 36},
+    { 53, 44},
+};
+
 Ultimate::Ultimate(socd::SocdType socd_type) {
     _socd_pair_count = 4;
     _socd_pairs = new socd::SocdPair[_socd_pair_count]{
@@ -13,6 +25,12 @@ Ultimate::Ultimate(socd::SocdType socd_type) {
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
     };
+    SetN64AxisMap(
+        n64_x_points,
+        sizeof(n64_x_points) / sizeof(N64AxisPoint),
+        n64_y_points,
+        sizeof(n64_y_points) / sizeof(N64AxisPoint)
+    );
 }
 
 void Ultimate::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
@@ -0,0 +1,104 @@
+#include "core/analog.hpp"
+#include "host.hpp"
+
+#include <unity.h>
+
+void setUp() {
+    host::reset();
+}
+
+void tearDown() {}
+
+void test_average_picks_its_channel_from_interleaved_samples() {
+    const uint16_t samples[] = { 100, 2000, 30, 102, 2004, 31, 104, 2008, 33 };
+
+    TEST_ASSERT_EQUAL_UINT16(102, analog::average(samples, 3, 3, 0));
+    TEST_ASSERT_EQUAL_UINT16(2004, analog::average(samples, 3, 3, 1));
+    TEST_ASSERT_EQUAL_UINT16(31, analog::average(samples, 3, 3, 2));
+
+    // Only the first sample_count samples of each channel are used.
+    TEST_ASSERT_EQUAL_UINT16(101, analog::average(samples, 3, 2, 0));
+    TEST_ASSERT_EQUAL_UINT16(2000, analog::average(samples, 3, 1, 1));
+}
+
+void test_average_rounds_to_nearest() {
+    // 10.5 rounds up, 10.25 rounds down and 10.75 rounds up.
+    const uint16_t half[] = { 10, 11 };
+    const uint16_t quarter[] = { 10, 10, 10, 11 };
+    const uint16_t three_quarters[] = { 10, 11, 11, 11 };
+
+    TEST_ASSERT_EQUAL_UINT16(11, analog::average(half, 1, 2, 0));
+    TEST_ASSERT_EQUAL_UINT16(10, analog::average(quarter, 1, 4, 0));
+    TEST_ASSERT_EQUAL_UINT16(11, analog::average(three_quarters, 1, 4, 0));
+}
+
+void test_average_does_not_overflow_at_full_scale() {
+    uint16_t samples[64];
+    for (size_t i = 0; i < 64; i++) {
+        samples[i] = 0xFFFF;
+    }
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, analog::average(samples, 2, 32, 1));
+}
+
+void test_calibrate_scales_between_released_and_pressed() {
+    analog::ChannelCalibration calibration = { 1000, 3000 };
+
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(1000, calibration));
+    TEST_ASSERT_EQUAL_UINT8(127, analog::calibrate(2000, calibration));
+    TEST_ASSERT_EQUAL_UINT8(255, analog::calibrate(3000, calibration));
+}
+
+void test_calibrate_handles_inverted_sensors() {
+    analog::ChannelCalibration calibration = { 3000, 1000 };
+
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(3000, calibration));
+    TEST_ASSERT_EQUAL_UINT8(127, analog::calibrate(2000, calibration));
+    TEST_ASSERT_EQUAL_UINT8(255, analog::calibrate(1000, calibration));
+}
+
+void test_calibrate_cuts_off_below_deadzone() {
+    analog::ChannelCalibration calibration = { 1000, 3000, 20 };
+
+    // 150 past released scales to 19, and 160 past released to 20.
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(1150, calibration));
+    TEST_ASSERT_EQUAL_UINT8(20, analog::calibrate(1160, calibration));
+    TEST_ASSERT_EQUAL_UINT8(255, analog::calibrate(3000, calibration));
+
+    analog::ChannelCalibration inverted = { 3000, 1000, 20 };
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(2850, inverted));
+    TEST_ASSERT_EQUAL_UINT8(20, analog::calibrate(2840, inverted));
+}
+
+void test_calibrate_clamps_beyond_either_end() {
+    analog::ChannelCalibration calibration = { 1000, 3000 };
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(0, calibration));
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(999, calibration));
+    TEST_ASSERT_EQUAL_UINT8(255, analog::calibrate(3001, calibration));
+    TEST_ASSERT_EQUAL_UINT8(255, analog::calibrate(0xFFFF, calibration));
+
+    analog::ChannelCalibration inverted = { 3000, 1000 };
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(0xFFFF, inverted));
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(3001, inverted));
+    TEST_ASSERT_EQUAL_UINT8(255, analog::calibrate(999, inverted));
+    TEST_ASSERT_EQUAL_UINT8(255, analog::calibrate(0, inverted));
+}
+
+void test_calibrate_without_travel_reports_released() {
+    analog::ChannelCalibration calibration = { 2000, 2000 };
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(0, calibration));
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(2000, calibration));
+    TEST_ASSERT_EQUAL_UINT8(0, analog::calibrate(0xFFFF, calibration));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_average_picks_its_channel_from_interleaved_samples);
+    RUN_TEST(test_average_rounds_to_nearest);
+    RUN_TEST(test_average_does_not_overflow_at_full_scale);
+    RUN_TEST(test_calibrate_scales_between_released_and_pressed);
+    RUN_TEST(test_calibrate_handles_inverted_sensors);
+    RUN_TEST(test_calibrate_cuts_off_below_deadzone);
+    RUN_TEST(test_calibrate_clamps_beyond_either_end);
+    RUN_TEST(test_calibrate_without_travel_reports_released);
+    return UNITY_END();
+}
@@ -0,0 +1,66 @@
+#include "core/boot_profile.hpp"
+#include "host.hpp"
+#include "serial.hpp"
+
+#include <string.h>
+#include <unity.h>
+
+#define FRAME_SIZE (sizeof(boot_profile::boot_profile_record_t) + 2)
+
+void setUp() {
+    host::reset();
+    serial::init(115200);
+}
+
+void tearDown() {}
+
+void test_frame_is_only_sent_if_it_fits() {
+    host::set_serial_write_space(FRAME_SIZE - 1);
+    TEST_ASSERT_FALSE(boot_profile::send());
+
+    uint8_t frame[FRAME_SIZE];
+    TEST_ASSERT_EQUAL(0, host::serial_output(frame, sizeof(frame)));
+
+    host::set_serial_write_space(FRAME_SIZE);
+    TEST_ASSERT_TRUE(boot_profile::send());
+    TEST_ASSERT_EQUAL(FRAME_SIZE, host::serial_output(frame, sizeof(frame)));
+}
+
+// Stage marks are kept for the lifetime of the process, so they are only set up once.
+void test_frame_holds_first_mark_of_each_stage() {
+    host::set_micros(100);
+    boot_profile::mark(boot_profile::STAGE_INPUT_INIT);
+    host::set_micros(250);
+    boot_profile::mark(boot_profile::STAGE_MODE_INIT);
+    host::set_micros(900);
+    boot_profile::mark(boot_profile::STAGE_INPUT_INIT);
+
+    TEST_ASSERT_TRUE(boot_profile::send());
+
+    uint8_t frame[FRAME_SIZE + 1];
+    TEST_ASSERT_EQUAL(FRAME_SIZE, host::serial_output(frame, sizeof(frame)));
+    TEST_ASSERT_EQUAL_HEX8(BOOT_PROFILE_FRAME_HEADER, frame[0]);
+
+    uint8_t checksum = 0;
+    for (size_t i = 1; i < FRAME_SIZE - 1; i++) {
+        checksum ^= frame[i];
+    }
+    TEST_ASSERT_EQUAL_HEX8(checksum, frame[FRAME_SIZE - 1]);
+
+    boot_profile::boot_profile_record_t record;
+    memcpy(&record, &frame[1], sizeof(record));
+    TEST_ASSERT_EQUAL(boot_profile::STAGE_COUNT, record.stage_count);
+    TEST_ASSERT_EQUAL_UINT32(100, record.timestamps_us[boot_profile::STAGE_INPUT_INIT]);
+    TEST_ASSERT_EQUAL_UINT32(250, record.timestamps_us[boot_profile::STAGE_MODE_INIT]);
+    TEST_ASSERT_EQUAL_HEX32(
+        BOOT_PROFILE_NOT_MARKED,
+        record.timestamps_us[boot_profile::STAGE_FIRST_REPORT]
+    );
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_is_only_sent_if_it_fits);
+    RUN_TEST(test_frame_holds_first_mark_of_each_stage);
+    return UNITY_END();
+}
@@ -0,0 +1,86 @@
+#include "host.hpp"
+
+#include <joybus_utils.hpp>
+#include <persistent_storage.hpp>
+#include <unity.h>
+
+#define JOYBUS_PIN 28
+#define VBUS_SENSE_PIN 24
+#define CONSOLE_HINT_MAGIC 0xC5
+
+static const ConnectedConsole hints[] = {
+    ConnectedConsole::GAMECUBE,
+    ConnectedConsole::N64,
+    ConnectedConsole::NONE,
+};
+
+void setUp() {
+    host::reset();
+}
+
+void tearDown() {}
+
+void test_vbus_powered_only_probes_gamecube() {
+    for (ConnectedConsole hint : hints) {
+        ConnectedConsole order[2];
+        TEST_ASSERT_EQUAL(1, console_probe_order(hint, true, order));
+        TEST_ASSERT_EQUAL(ConnectedConsole::GAMECUBE, order[0]);
+    }
+}
+
+void test_n64_hint_probes_n64_first() {
+    ConnectedConsole order[2];
+    TEST_ASSERT_EQUAL(2, console_probe_order(ConnectedConsole::N64, false, order));
+    TEST_ASSERT_EQUAL(ConnectedConsole::N64, order[0]);
+    TEST_ASSERT_EQUAL(ConnectedConsole::GAMECUBE, order[1]);
+}
+
+void test_other_hints_probe_gamecube_first() {
+    for (ConnectedConsole hint : hints) {
+        if (hint == ConnectedConsole::N64) {
+            continue;
+        }
+        ConnectedConsole order[2];
+        TEST_ASSERT_EQUAL(2, console_probe_order(hint, false, order));
+        TEST_ASSERT_EQUAL(ConnectedConsole::GAMECUBE, order[0]);
+        TEST_ASSERT_EQUAL(ConnectedConsole::N64, order[1]);
+    }
+}
+
+// Detection is cached for the lifetime of the process, so detect_console() can only be exercised
+// once per test binary.
+void test_detect_uses_hint_and_updates_it() {
+    uint8_t hint = (uint8_t)ConnectedConsole::GAMECUBE;
+    persistent_storage::write(STORAGE_CONSOLE_HINT_ADDR, CONSOLE_HINT_MAGIC, &hint, 1);
+    size_t commits = host::storage_commits();
+    host::set_pin(VBUS_SENSE_PIN, false);
+    host::set_joybus_console(ConnectedConsole::N64);
+
+    TEST_ASSERT_EQUAL(ConnectedConsole::N64, detect_console(JOYBUS_PIN));
+
+    ConnectedConsole probes[4];
+    TEST_ASSERT_EQUAL(2, host::joybus_probes(probes, 4));
+    TEST_ASSERT_EQUAL(ConnectedConsole::GAMECUBE, probes[0]);
+    TEST_ASSERT_EQUAL(ConnectedConsole::N64, probes[1]);
+
+    TEST_ASSERT_TRUE(
+        persistent_storage::read(STORAGE_CONSOLE_HINT_ADDR, CONSOLE_HINT_MAGIC, &hint, 1)
+    );
+    TEST_ASSERT_EQUAL((uint8_t)ConnectedConsole::N64, hint);
+    TEST_ASSERT_EQUAL(commits + 1, host::storage_commits());
+
+    // The detecting instance is handed over to a backend on the same pin with default settings.
+    N64Console *n64 = take_detected_n64(JOYBUS_PIN, pio0, -1, -1);
+    TEST_ASSERT_NOT_NULL(n64);
+    TEST_ASSERT_NULL(take_detected_n64(JOYBUS_PIN, pio0, -1, -1));
+    delete n64;
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_vbus_powered_only_probes_gamecube);
+    RUN_TEST(test_n64_hint_probes_n64_first);
+    RUN_TEST(test_other_hints_probe_gamecube_first);
+    RUN_TEST(test_detect_uses_hint_and_updates_it);
+    return UNITY_END();
+}
@@ -0,0 +1,176 @@
+#include "comms/ConsoleStandIn.hpp"
+#include "comms/GamecubeBackend.hpp"
+#include "comms/N64Backend.hpp"
+#include "core/InputSource.hpp"
+#include "host.hpp"
+#include "modes/Melee20Button.hpp"
+
+#include <unity.h>
+
+#define POLL_INTERVAL_US 1000
+#define POLLS 100
+
+// Joybus poll lengths, from the start of the command until the reply is due.
+#define GAMECUBE_POLL_US 100
+#define N64_POLL_US 36
+
+// Reports whatever inputs the test sets, and can take a while doing it.
+class HeldInputs : public InputSource {
+  public:
+    InputState held;
+    InputScanSpeed speed = InputScanSpeed::FAST;
+    uint32_t scan_us = 0;
+
+    InputScanSpeed ScanSpeed() { return speed; }
+    void UpdateInputs(InputState &inputs) {
+        busy_wait_us(scan_us);
+        inputs = held;
+    }
+};
+
+static const console_timing_t timing = {
+    .poll_interval_us = POLL_INTERVAL_US,
+    .jitter_us = 0,
+    .reply_timeout_us = 60,
+    .seed = 1,
+};
+
+static HeldInputs *held;
+static InputSource *input_sources[1];
+
+void setUp() {
+    host::reset();
+    held = new HeldInputs();
+    input_sources[0] = held;
+}
+
+void tearDown() {
+    delete held;
+}
+
+static void run_gamecube(GamecubeConsoleStandIn *console, size_t polls) {
+    GamecubeBackend backend(input_sources, 1, console);
+    backend.SetGameMode(new Melee20Button(socd::SOCD_2IP_NO_REAC));
+    for (size_t i = 0; i < polls; i++) {
+        backend.SendReport();
+    }
+}
+
+void test_gamecube_replies_when_poll_ends() {
+    GamecubeConsoleStandIn *console = new GamecubeConsoleStandIn(timing);
+    uint32_t log[POLLS];
+    console->SetReplyLog(log, POLLS);
+    held->held.a = true;
+
+    run_gamecube(console, POLLS);
+
+    console_stats_t stats;
+    console->GetStats(stats);
+    TEST_ASSERT_EQUAL_UINT32(POLLS, stats.polls);
+    TEST_ASSERT_EQUAL_UINT32(POLLS, stats.replies);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.late);
+    TEST_ASSERT_EQUAL(POLLS, console->ReplyLogLength());
+    for (size_t i = 0; i < POLLS; i++) {
+        TEST_ASSERT_EQUAL_UINT32(GAMECUBE_POLL_US, log[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)POLLS * POLL_INTERVAL_US + GAMECUBE_POLL_US, time_us_64());
+}
+
+void test_gamecube_report_comes_from_mode() {
+    GamecubeConsoleStandIn *console = new GamecubeConsoleStandIn(timing);
+    held->held.a = true;
+    held->held.left = true;
+    GamecubeBackend backend(input_sources, 1, console);
+    backend.SetGameMode(new Melee20Button(socd::SOCD_2IP_NO_REAC));
+    backend.SendReport();
+
+    TEST_ASSERT_EQUAL(1, console->LastReport().a);
+    TEST_ASSERT_EQUAL(0, console->LastReport().b);
+    TEST_ASSERT_LESS_THAN_UINT8(128, console->LastReport().stick_x);
+    TEST_ASSERT_EQUAL_UINT8(128, console->LastReport().stick_y);
+}
+
+void test_slow_fast_inputs_make_replies_late() {
+    GamecubeConsoleStandIn *console = new GamecubeConsoleStandIn(timing);
+    held->scan_us = 200;
+
+    run_gamecube(console, 10);
+
+    console_stats_t stats;
+    console->GetStats(stats);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.late);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.replies);
+    TEST_ASSERT_GREATER_THAN_UINT32(GAMECUBE_POLL_US + timing.reply_timeout_us, stats.min_reply_us);
+}
+
+void test_slow_inputs_before_poll_miss_polls() {
+    // Slow inputs are scanned before waiting for the poll, so taking longer than a poll interval
+    // means a poll goes by unanswered.
+    GamecubeConsoleStandIn *console = new GamecubeConsoleStandIn(timing);
+    held->speed = InputScanSpeed::SLOW;
+    held->scan_us = POLL_INTERVAL_US + 500;
+
+    run_gamecube(console, 10);
+
+    console_stats_t stats;
+    console->GetStats(stats);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.replies);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.late);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(20, stats.polls);
+}
+
+void test_jitter_is_repeatable_and_bounded() {
+    console_timing_t jittery = timing;
+    jittery.jitter_us = 200;
+    uint32_t starts[2][POLLS];
+
+    for (size_t run = 0; run < 2; run++) {
+        host::set_micros(0);
+        GamecubeConsoleStandIn console(jittery);
+        for (size_t i = 0; i < POLLS; i++) {
+            console.WaitForPollStart();
+            starts[run][i] = time_us_32();
+            console.WaitForPollEnd();
+        }
+    }
+
+    bool varied = false;
+    for (size_t i = 1; i < POLLS; i++) {
+        uint32_t interval = starts[0][i] - starts[0][i - 1];
+        TEST_ASSERT_UINT32_WITHIN(2 * jittery.jitter_us, POLL_INTERVAL_US, interval);
+        varied |= interval != POLL_INTERVAL_US;
+        TEST_ASSERT_EQUAL_UINT32(starts[0][i], starts[1][i]);
+    }
+    TEST_ASSERT_TRUE(varied);
+}
+
+void test_n64_replies_when_poll_ends() {
+    N64ConsoleStandIn *console = new N64ConsoleStandIn(timing);
+    held->held.a = true;
+    N64Backend backend(input_sources, 1, console);
+    backend.SetGameMode(new Melee20Button(socd::SOCD_2IP_NO_REAC));
+    for (size_t i = 0; i < POLLS; i++) {
+        backend.SendReport();
+    }
+
+    console_stats_t stats;
+    console->GetStats(stats);
+    TEST_ASSERT_EQUAL_UINT32(POLLS, stats.replies);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.late);
+    TEST_ASSERT_EQUAL_UINT32(N64_POLL_US, stats.min_reply_us);
+    TEST_ASSERT_EQUAL_UINT32(N64_POLL_US, stats.max_reply_us);
+    TEST_ASSERT_EQUAL(1, console->LastReport().a);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_gamecube_replies_when_poll_ends);
+    RUN_TEST(test_gamecube_report_comes_from_mode);
+    RUN_TEST(test_slow_fast_inputs_make_replies_late);
+    RUN_TEST(test_slow_inputs_before_poll_miss_polls);
+    RUN_TEST(test_jitter_is_repeatable_and_bounded);
+    RUN_TEST(test_n64_replies_when_poll_ends);
+    return UNITY_END();
+}
@@ -0,0 +1,123 @@
+#include "display/FrameScheduler.hpp"
+#include "host.hpp"
+
+#include <unity.h>
+
+#define FRAME_RATE 60
+#define PERIOD_US (1000000 / FRAME_RATE)
+
+void setUp() {
+    host::reset();
+    host::set_micros(1000000);
+}
+
+void tearDown() {}
+
+// Runs a loop that checks for a frame every loop_us and takes draw_us to draw one, like loop1().
+static void run_loop(
+    FrameScheduler &scheduler,
+    uint32_t duration_us,
+    uint32_t loop_us,
+    uint32_t draw_us
+) {
+    uint64_t end = micros() + duration_us;
+    while (micros() < end) {
+        if (scheduler.FrameDue(micros())) {
+            host::advance_micros(draw_us);
+            scheduler.FrameDone(micros());
+        }
+        host::advance_micros(loop_us);
+    }
+}
+
+void test_first_frame_is_due_straight_away() {
+    FrameScheduler scheduler(FRAME_RATE);
+    TEST_ASSERT_TRUE(scheduler.FrameDue(micros()));
+    scheduler.FrameDone(micros());
+
+    host::advance_micros(PERIOD_US - 1);
+    TEST_ASSERT_FALSE(scheduler.FrameDue(micros()));
+    host::advance_micros(1);
+    TEST_ASSERT_TRUE(scheduler.FrameDue(micros()));
+}
+
+void test_fast_loop_draws_at_frame_rate() {
+    FrameScheduler scheduler(FRAME_RATE);
+    run_loop(scheduler, 1000000, 100, 2000);
+
+    TEST_ASSERT_EQUAL_UINT32(FRAME_RATE, scheduler.FramesDrawn());
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.FramesSkipped());
+    TEST_ASSERT_EQUAL_UINT32(2000, scheduler.FrameTime());
+    TEST_ASSERT_EQUAL_UINT32(2000, scheduler.MaxFrameTime());
+}
+
+void test_slow_frame_skips_missed_frames_and_keeps_cadence() {
+    FrameScheduler scheduler(FRAME_RATE);
+    uint32_t start = micros();
+    TEST_ASSERT_TRUE(scheduler.FrameDue(micros()));
+    // Takes two and a half periods, so the frame one period in was missed, and the one two
+    // periods in is drawn late.
+    host::advance_micros(PERIOD_US * 5 / 2);
+    scheduler.FrameDone(micros());
+
+    TEST_ASSERT_TRUE(scheduler.FrameDue(micros()));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.FramesSkipped());
+    scheduler.FrameDone(micros());
+    TEST_ASSERT_EQUAL_UINT32(PERIOD_US * 5 / 2, scheduler.MaxFrameTime());
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.FrameTime());
+
+    // The next frame is still due on the original grid, not a period after the late one.
+    host::set_micros(start + PERIOD_US * 3 - 1);
+    TEST_ASSERT_FALSE(scheduler.FrameDue(micros()));
+    host::set_micros(start + PERIOD_US * 3);
+    TEST_ASSERT_TRUE(scheduler.FrameDue(micros()));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.FramesSkipped());
+}
+
+void test_slow_drawing_never_exceeds_frame_rate() {
+    FrameScheduler scheduler(FRAME_RATE);
+    // Every frame takes one and a half periods, so one frame in three is skipped, and every frame
+    // is either drawn or counted as skipped.
+    run_loop(scheduler, 1000000, 100, PERIOD_US + PERIOD_US / 2);
+
+    TEST_ASSERT_UINT32_WITHIN(1, FRAME_RATE * 2 / 3, scheduler.FramesDrawn());
+    TEST_ASSERT_UINT32_WITHIN(1, FRAME_RATE / 3, scheduler.FramesSkipped());
+    TEST_ASSERT_UINT32_WITHIN(1, FRAME_RATE, scheduler.FramesDrawn() + scheduler.FramesSkipped());
+}
+
+void test_skipped_frame_is_counted() {
+    FrameScheduler scheduler(FRAME_RATE);
+    TEST_ASSERT_TRUE(scheduler.FrameDue(micros()));
+    scheduler.SkipFrame();
+
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.FramesDrawn());
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.FramesSkipped());
+    // The skipped frame's slot is used up.
+    TEST_ASSERT_FALSE(scheduler.FrameDue(micros()));
+}
+
+void test_counter_wraparound() {
+    FrameScheduler scheduler(FRAME_RATE);
+    uint32_t now = 0xFFFFFFFF - PERIOD_US / 2;
+    TEST_ASSERT_TRUE(scheduler.FrameDue(now));
+    scheduler.FrameDone(now);
+
+    now += PERIOD_US - 1;
+    TEST_ASSERT_FALSE(scheduler.FrameDue(now));
+    now += 1;
+    TEST_ASSERT_TRUE(scheduler.FrameDue(now));
+    scheduler.FrameDone(now + 10);
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.FrameTime());
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.FramesSkipped());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_is_due_straight_away);
+    RUN_TEST(test_fast_loop_draws_at_frame_rate);
+    RUN_TEST(test_slow_frame_skips_missed_frames_and_keeps_cadence);
+    RUN_TEST(test_slow_drawing_never_exceeds_frame_rate);
+    RUN_TEST(test_skipped_frame_is_counted);
+    RUN_TEST(test_counter_wraparound);
+    return UNITY_END();
+}
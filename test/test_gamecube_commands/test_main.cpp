@@ -0,0 +1,111 @@
+#include "comms/ConsoleStandIn.hpp"
+#include "comms/GamecubeBackend.hpp"
+#include "core/InputSource.hpp"
+#include "host.hpp"
+#include "modes/Melee20Button.hpp"
+
+#include <unity.h>
+
+// Reports whatever inputs the test sets.
+class HeldInputs : public InputSource {
+  public:
+    InputState held;
+
+    InputScanSpeed ScanSpeed() { return InputScanSpeed::FAST; }
+    void UpdateInputs(InputState &inputs) { inputs = held; }
+};
+
+static HeldInputs *held;
+static InputSource *input_sources[1];
+static GamecubeConsoleStandIn *console;
+static GamecubeBackend *backend;
+
+void setUp() {
+    host::reset();
+    held = new HeldInputs();
+    input_sources[0] = held;
+    console = new GamecubeConsoleStandIn();
+    backend = new GamecubeBackend(input_sources, 1, console);
+    backend->SetGameMode(new Melee20Button(socd::SOCD_2IP_NO_REAC));
+}
+
+void tearDown() {
+    delete backend;
+    delete held;
+}
+
+void test_rumble_bit_is_decoded() {
+    const JoybusCommand commands[] = {
+        JoybusCommand::POLL_RUMBLE,
+        JoybusCommand::POLL,
+    };
+    console->SetCommands(commands, 2);
+
+    backend->SendReport();
+    TEST_ASSERT_TRUE(backend->GetFeedback().rumble);
+    backend->SendReport();
+    TEST_ASSERT_FALSE(backend->GetFeedback().rumble);
+}
+
+void test_invalid_poll_is_not_answered() {
+    const JoybusCommand commands[] = {
+        JoybusCommand::POLL_RUMBLE,
+        JoybusCommand::POLL_INVALID,
+    };
+    console->SetCommands(commands, 2);
+    held->held.a = true;
+
+    backend->SendReport();
+    backend->SendReport();
+
+    // The rumble state from the last valid poll is kept.
+    TEST_ASSERT_TRUE(backend->GetFeedback().rumble);
+
+    console_stats_t stats;
+    console->GetStats(stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.polls);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.replies);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.late);
+
+    poll_stats_t poll_stats;
+    backend->GetPollStats().Get(poll_stats);
+    TEST_ASSERT_EQUAL_UINT32(1, poll_stats.skipped_polls);
+
+    // The published report is still the one from the valid poll.
+    gc_report_t report;
+    backend->GetLastReport(report);
+    TEST_ASSERT_EQUAL(1, report.a);
+}
+
+// joybus-pio answers probe, origin and recalibrate commands without involving the backend, so all
+// the backend sees of them is the time they take between polls.
+void test_commands_between_polls_keep_replies_on_time() {
+    const JoybusCommand commands[] = {
+        JoybusCommand::POLL,
+        JoybusCommand::ORIGIN,
+        JoybusCommand::POLL_RUMBLE,
+        JoybusCommand::PROBE,
+        JoybusCommand::POLL,
+    };
+    console->SetCommands(commands, 5);
+
+    for (size_t i = 0; i < 3; i++) {
+        backend->SendReport();
+    }
+
+    console_stats_t stats;
+    console->GetStats(stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.replies);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.commands);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.late);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_FALSE(backend->GetFeedback().rumble);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_rumble_bit_is_decoded);
+    RUN_TEST(test_invalid_poll_is_not_answered);
+    RUN_TEST(test_commands_between_polls_keep_replies_on_time);
+    return UNITY_END();
+}
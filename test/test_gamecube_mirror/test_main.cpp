@@ -0,0 +1,129 @@
+#include "comms/ConsoleStandIn.hpp"
+#include "comms/GamecubeBackend.hpp"
+#include "comms/GamecubeMirrorBackend.hpp"
+#include "core/InputSource.hpp"
+#include "host.hpp"
+#include "modes/Melee20Button.hpp"
+
+#include <unity.h>
+
+// Counts how often it is scanned, i.e. how often the primary backend ran the mode.
+class CountingInputs : public InputSource {
+  public:
+    InputState held;
+    size_t scans = 0;
+
+    InputScanSpeed ScanSpeed() { return InputScanSpeed::FAST; }
+    void UpdateInputs(InputState &inputs) {
+        scans++;
+        inputs = held;
+    }
+};
+
+// The capture adapter on the mirror port polls far more often than the console.
+static constexpr console_timing_t mirror_timing = {
+    .poll_interval_us = 1000,
+    .jitter_us = 100,
+    .reply_timeout_us = 60,
+    .seed = 7,
+};
+
+static CountingInputs *counting;
+static InputSource *input_sources[1];
+static GamecubeConsoleStandIn *console;
+static GamecubeConsoleStandIn *capture;
+static GamecubeBackend *primary;
+static GamecubeMirrorBackend *mirror;
+
+void setUp() {
+    host::reset();
+    counting = new CountingInputs();
+    input_sources[0] = counting;
+    console = new GamecubeConsoleStandIn();
+    primary = new GamecubeBackend(input_sources, 1, console);
+    primary->SetGameMode(new Melee20Button(socd::SOCD_2IP_NO_REAC));
+    capture = new GamecubeConsoleStandIn(mirror_timing);
+    mirror = new GamecubeMirrorBackend(primary, capture);
+}
+
+void tearDown() {
+    delete mirror;
+    delete primary;
+    delete counting;
+}
+
+static void assert_same_report(const gc_report_t &expected, const gc_report_t &actual) {
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&expected, &actual, sizeof(gc_report_t));
+}
+
+void test_mirror_sends_default_report_before_first_poll() {
+    mirror->SendReport();
+    assert_same_report(default_gc_report, capture->LastReport());
+    TEST_ASSERT_EQUAL(0, counting->scans);
+}
+
+void test_mirror_sends_last_published_report() {
+    counting->held.a = true;
+    counting->held.left = true;
+    primary->SendReport();
+
+    mirror->SendReport();
+    assert_same_report(console->LastReport(), capture->LastReport());
+    TEST_ASSERT_EQUAL(1, capture->LastReport().a);
+
+    // Inputs that the primary port hasn't sent yet don't reach the mirror.
+    counting->held.a = false;
+    counting->held.b = true;
+    mirror->SendReport();
+    TEST_ASSERT_EQUAL(1, capture->LastReport().a);
+    TEST_ASSERT_EQUAL(0, capture->LastReport().b);
+
+    primary->SendReport();
+    mirror->SendReport();
+    assert_same_report(console->LastReport(), capture->LastReport());
+    TEST_ASSERT_EQUAL(0, capture->LastReport().a);
+    TEST_ASSERT_EQUAL(1, capture->LastReport().b);
+}
+
+void test_mirror_answers_its_own_polls_without_mode_logic() {
+    counting->held.a = true;
+    primary->SendReport();
+    size_t scans = counting->scans;
+    console_stats_t before;
+    capture->GetStats(before);
+
+    // Many mirror polls fit between two console polls, and each is answered on time from the
+    // published report.
+    for (int i = 0; i < 10; i++) {
+        mirror->SendReport();
+        assert_same_report(console->LastReport(), capture->LastReport());
+    }
+
+    console_stats_t after;
+    capture->GetStats(after);
+    TEST_ASSERT_EQUAL_UINT32(before.replies + 10, after.replies);
+    TEST_ASSERT_EQUAL_UINT32(before.late, after.late);
+    TEST_ASSERT_EQUAL(scans, counting->scans);
+
+    // The console doesn't see any of them.
+    console_stats_t console_stats;
+    console->GetStats(console_stats);
+    TEST_ASSERT_EQUAL_UINT32(1, console_stats.replies);
+}
+
+void test_rumble_is_kept_per_port() {
+    capture->SetRumble(true);
+    primary->SendReport();
+    mirror->SendReport();
+    TEST_ASSERT_TRUE(mirror->GetFeedback().rumble);
+    TEST_ASSERT_FALSE(primary->GetFeedback().rumble);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_mirror_sends_default_report_before_first_poll);
+    RUN_TEST(test_mirror_sends_last_published_report);
+    RUN_TEST(test_mirror_answers_its_own_polls_without_mode_logic);
+    RUN_TEST(test_rumble_is_kept_per_port);
+    return UNITY_END();
+}
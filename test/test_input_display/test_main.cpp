@@ -0,0 +1,404 @@
+#include "core/state.hpp"
+#include "display/InputDisplay.hpp"
+#include "display/layouts.hpp"
+#include "host.hpp"
+#include "i2c_bus.hpp"
+
+#include <lib/OneBitDisplay/OneBitDisplay.h>
+#include <string.h>
+#include <unity.h>
+
+#define WIDTH 128
+#define HEIGHT 64
+#define BUFFER_SIZE (WIDTH * HEIGHT / 8)
+#define OLED_ADDRESS 0x3C
+#define NUNCHUK_ADDRESS 0x52
+#define NUNCHUK_REPORT_BYTES 6
+#define SPI_SCK_PIN 18
+#define SPI_MOSI_PIN 19
+#define SPI_CS_PIN 17
+#define SPI_DC_PIN 20
+
+static OBDISP obd;
+static uint8_t back_buffer[BUFFER_SIZE];
+
+void setUp() {
+    host::reset();
+    memset(&obd, 0, sizeof(obd));
+    memset(back_buffer, 0, sizeof(back_buffer));
+}
+
+void tearDown() {}
+
+// Brings up a 128x64 SSD1306 on hardware I2C, the same way the Pico config does, so that the
+// input display sends its tiles with DMA.
+static void init_panel() {
+    host::attach_oled_i2c(i2c0, OLED_ADDRESS);
+    int result = obdI2CInit(&obd, OLED_128x64, OLED_ADDRESS, 0, 0, 1, 4, 5, i2c0, -1, 400000);
+    TEST_ASSERT_NOT_EQUAL(OLED_NOT_FOUND, result);
+    obdSetBackBuffer(&obd, back_buffer);
+    obdFill(&obd, 0, 1);
+}
+
+// The same panel on hardware SPI.
+static void init_spi_panel() {
+    host::attach_oled_spi(spi0, SPI_CS_PIN, SPI_DC_PIN);
+    obd.bbi2c.picoSPI = spi0;
+    obdSPIInit(
+        &obd,
+        OLED_128x64,
+        SPI_DC_PIN,
+        SPI_CS_PIN,
+        -1,
+        SPI_MOSI_PIN,
+        SPI_SCK_PIN,
+        -1,
+        0,
+        0,
+        0,
+        8000000
+    );
+    obdSetBackBuffer(&obd, back_buffer);
+    obdFill(&obd, 0, 1);
+}
+
+static void add_layout(InputDisplay &display) {
+    display.AddLayout(layouts::get(LeftLayout::CIRCLES));
+    display.AddLayout(layouts::get(CenterLayout::CIRCLES));
+    display.AddLayout(layouts::get(RightLayout::CIRCLES));
+}
+
+// Draws the inputs from scratch onto an off-screen display.
+static void full_redraw(
+    const char *const *labels,
+    InputState &inputs,
+    uint8_t buffer[BUFFER_SIZE]
+) {
+    OBDISP canvas = {};
+    memset(buffer, 0, BUFFER_SIZE);
+    obdCreateVirtualDisplay(&canvas, WIDTH, HEIGHT, buffer);
+    InputDisplay display(&canvas);
+    add_layout(display);
+    for (int i = 0; i < LABEL_COUNT; i++) {
+        display.SetLabel((DisplayLabel)i, labels[i]);
+    }
+    display.Update(inputs);
+}
+
+// The panel's memory for the visible columns, laid out like the display's buffer.
+static void read_panel(uint8_t buffer[BUFFER_SIZE]) {
+    uint8_t memory[OLED_PANEL_PAGES][OLED_PANEL_COLUMNS];
+    host::oled_memory(&memory[0][0], sizeof(memory));
+    for (int page = 0; page < HEIGHT / 8; page++) {
+        memcpy(&buffer[page * WIDTH], memory[page], WIDTH);
+    }
+}
+
+static uint32_t next_random(uint32_t &seed) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+// Changes inputs and labels at random and checks after every update that the panel shows the same
+// as a display drawn from scratch. The panel must have been initialized.
+static void check_dirty_tiles_match_full_redraw() {
+    InputDisplay display(&obd);
+    add_layout(display);
+
+    const ButtonLayout *sides[] = {
+        &layouts::get(LeftLayout::CIRCLES),
+        &layouts::get(CenterLayout::CIRCLES),
+        &layouts::get(RightLayout::CIRCLES),
+    };
+    static const char *const label_choices[] = { nullptr, "P1", "Melee", "Ultimate", "1000Hz" };
+    const char *labels[LABEL_COUNT] = {};
+
+    InputState inputs;
+    uint8_t expected[BUFFER_SIZE];
+    uint8_t panel[BUFFER_SIZE];
+    uint32_t seed = 1;
+
+    for (int step = 0; step < 300; step++) {
+        // Change a few buttons each step, which often includes neighbours whose bounds overlap.
+        int changes = 1 + next_random(seed) % 3;
+        for (int i = 0; i < changes; i++) {
+            const ButtonLayout &side = *sides[next_random(seed) % 3];
+            const DisplayButton &button = side.buttons[next_random(seed) % side.button_count];
+            inputs.*(button.input) = !(inputs.*(button.input));
+        }
+        if (step % 17 == 0) {
+            DisplayLabel label = (DisplayLabel)(next_random(seed) % LABEL_COUNT);
+            labels[label] = label_choices[next_random(seed) % 5];
+            display.SetLabel(label, labels[label]);
+        }
+
+        display.Update(inputs);
+        TEST_ASSERT_TRUE(display.Ready());
+
+        full_redraw(labels, inputs, expected);
+        read_panel(panel);
+        char message[32];
+        snprintf(message, sizeof(message), "step %d", step);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(expected, back_buffer, BUFFER_SIZE, message);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(expected, panel, BUFFER_SIZE, message);
+    }
+}
+
+void test_dirty_tiles_match_full_redraw() {
+    init_panel();
+    check_dirty_tiles_match_full_redraw();
+}
+
+void test_dirty_tiles_match_full_redraw_on_spi() {
+    init_spi_panel();
+    size_t blocking_bytes = host::spi_blocking_bytes();
+    check_dirty_tiles_match_full_redraw();
+    // Every run's command and data went out by DMA, with nothing written by the CPU.
+    TEST_ASSERT_EQUAL(blocking_bytes, host::spi_blocking_bytes());
+}
+
+void test_spi_runs_wait_for_each_transfer() {
+    init_spi_panel();
+    InputDisplay display(&obd);
+    add_layout(display);
+    InputState inputs;
+
+    // While the first transfer hasn't gone out, nothing else is sent and the display isn't ready.
+    host::hold_dma(true);
+    size_t sent = host::oled_data_bytes();
+    display.Update(inputs);
+    TEST_ASSERT_FALSE(display.Ready());
+    TEST_ASSERT_EQUAL(sent, host::oled_data_bytes());
+
+    // The rest of the frame follows from the completion interrupts alone.
+    host::hold_dma(false);
+    TEST_ASSERT_TRUE(display.Ready());
+    TEST_ASSERT_GREATER_THAN(sent, host::oled_data_bytes());
+
+    uint8_t expected[BUFFER_SIZE];
+    uint8_t panel[BUFFER_SIZE];
+    const char *labels[LABEL_COUNT] = {};
+    full_redraw(labels, inputs, expected);
+    read_panel(panel);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, panel, BUFFER_SIZE);
+}
+
+void test_i2c_transfer_waits_for_shared_block() {
+    init_panel();
+    InputDisplay display(&obd);
+    add_layout(display);
+    InputState inputs;
+
+    // The Nunchuk has read a report on the same block but not taken it out of the FIFO yet, so the
+    // frame is kept until it has.
+    i2c0->hw->tar = NUNCHUK_ADDRESS;
+    i2c0->hw->rxflr = NUNCHUK_REPORT_BYTES;
+    size_t sent = host::oled_data_bytes();
+    display.Update(inputs);
+    TEST_ASSERT_FALSE(display.Ready());
+    TEST_ASSERT_EQUAL(sent, host::oled_data_bytes());
+    TEST_ASSERT_EQUAL_HEX32(NUNCHUK_ADDRESS, i2c0->hw->tar);
+
+    // Checking again once the block is free starts the frame, pointed at the panel, and the
+    // Nunchuk sees the block as busy until the DMA transfer is done.
+    i2c0->hw->rxflr = 0;
+    host::hold_dma(true);
+    TEST_ASSERT_FALSE(display.Ready());
+    TEST_ASSERT_EQUAL_HEX32(OLED_ADDRESS, i2c0->hw->tar);
+    TEST_ASSERT_FALSE(i2c_bus::idle(i2c0));
+    host::hold_dma(false);
+    TEST_ASSERT_TRUE(display.Ready());
+    TEST_ASSERT_TRUE(i2c_bus::idle(i2c0));
+
+    uint8_t expected[BUFFER_SIZE];
+    uint8_t panel[BUFFER_SIZE];
+    const char *labels[LABEL_COUNT] = {};
+    full_redraw(labels, inputs, expected);
+    read_panel(panel);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, panel, BUFFER_SIZE);
+}
+
+void test_abort_during_other_transfer_is_left_alone() {
+    init_panel();
+    InputDisplay display(&obd);
+    // Spans columns 16-24 and rows 16-24, which is one tile in each of pages 2 and 3.
+    static const DisplayButton button = { &InputState::a, ButtonShape::CIRCLE, 20, 20 };
+    display.AddButtons(&button, 1);
+    InputState inputs;
+    display.Update(inputs);
+    size_t sent = host::oled_data_bytes();
+
+    // A Nunchuk transfer failed. The display doesn't take the abort for its own, so it doesn't
+    // send the whole screen again, and it waits for the Nunchuk to clear it.
+    i2c0->hw->tar = NUNCHUK_ADDRESS;
+    i2c0->hw->raw_intr_stat = I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+    inputs.a = true;
+    TEST_ASSERT_TRUE(display.Ready());
+    display.Update(inputs);
+    TEST_ASSERT_FALSE(display.Ready());
+    TEST_ASSERT_EQUAL(sent, host::oled_data_bytes());
+
+    i2c0->hw->raw_intr_stat = 0;
+    TEST_ASSERT_FALSE(display.Ready());
+    TEST_ASSERT_TRUE(display.Ready());
+    TEST_ASSERT_EQUAL(sent + 2 * INPUT_DISPLAY_TILE_WIDTH, host::oled_data_bytes());
+}
+
+void test_only_changed_tiles_are_sent() {
+    init_panel();
+    InputDisplay display(&obd);
+    // Spans columns 16-24 and rows 16-24, which is one tile in each of pages 2 and 3.
+    static const DisplayButton button = { &InputState::a, ButtonShape::CIRCLE, 20, 20 };
+    display.AddButtons(&button, 1);
+    static const char *label = "P1";
+    display.SetLabel(LABEL_LEFT, label);
+
+    InputState inputs;
+    display.Update(inputs);
+    size_t sent = host::oled_data_bytes();
+
+    // Nothing changed, so nothing is sent, even if the same label is set again.
+    display.Update(inputs);
+    display.SetLabel(LABEL_LEFT, label);
+    display.Update(inputs);
+    TEST_ASSERT_EQUAL(sent, host::oled_data_bytes());
+
+    inputs.a = true;
+    display.Update(inputs);
+    TEST_ASSERT_EQUAL(sent + 2 * INPUT_DISPLAY_TILE_WIDTH, host::oled_data_bytes());
+}
+
+// Draws a single button through the sprite atlas and the same shape directly with OneBitDisplay at
+// every row offset within a page, and checks that the two match pixel for pixel.
+static void check_sprite_matches_direct_drawing(ButtonShape shape) {
+    uint8_t sprite[BUFFER_SIZE];
+    uint8_t direct[BUFFER_SIZE];
+
+    for (int pressed = 0; pressed < 2; pressed++) {
+        for (int y = 4; y < 4 + 8; y++) {
+            const DisplayButton button = { &InputState::a, shape, 37, (uint8_t)y };
+
+            OBDISP canvas = {};
+            memset(sprite, 0, sizeof(sprite));
+            obdCreateVirtualDisplay(&canvas, WIDTH, HEIGHT, sprite);
+            InputDisplay display(&canvas);
+            display.AddButtons(&button, 1);
+            InputState inputs;
+            inputs.a = pressed;
+            display.Update(inputs);
+
+            OBDISP reference = {};
+            memset(direct, 0, sizeof(direct));
+            obdCreateVirtualDisplay(&reference, WIDTH, HEIGHT, direct);
+            if (shape == ButtonShape::CIRCLE) {
+                obdPreciseEllipse(&reference, button.x, button.y, 4, 4, 1, pressed);
+            } else {
+                int x = button.x;
+                obdRectangle(&reference, x, y, x + 6, y + 6, 1, pressed);
+            }
+
+            char message[32];
+            snprintf(message, sizeof(message), "pressed %d y %d", pressed, y);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(direct, sprite, BUFFER_SIZE, message);
+        }
+    }
+}
+
+void test_circle_sprite_matches_ellipse() {
+    check_sprite_matches_direct_drawing(ButtonShape::CIRCLE);
+}
+
+void test_square_sprite_matches_rectangle() {
+    check_sprite_matches_direct_drawing(ButtonShape::SQUARE);
+}
+
+// The top row as the labels used to be drawn, by clearing it and writing each label in turn.
+static void draw_labels_directly(const char *const *labels, uint8_t buffer[BUFFER_SIZE]) {
+    OBDISP canvas = {};
+    memset(buffer, 0, BUFFER_SIZE);
+    obdCreateVirtualDisplay(&canvas, WIDTH, HEIGHT, buffer);
+    for (int i = 0; i < LABEL_COUNT; i++) {
+        if (labels[i] == nullptr || labels[i][0] == '\0') {
+            continue;
+        }
+        int text_width = strlen(labels[i]) * 6;
+        int x = i == LABEL_LEFT     ? 0
+                : i == LABEL_CENTER ? (WIDTH - text_width) / 2
+                                    : WIDTH - text_width;
+        obdWriteString(&canvas, 0, x, 0, (char *)labels[i], FONT_6x8, 0, 0);
+    }
+}
+
+void test_labels_match_direct_drawing() {
+    uint8_t composited[BUFFER_SIZE];
+    uint8_t direct[BUFFER_SIZE];
+    OBDISP canvas = {};
+    memset(composited, 0, sizeof(composited));
+    obdCreateVirtualDisplay(&canvas, WIDTH, HEIGHT, composited);
+    InputDisplay display(&canvas);
+
+    // Each set of labels is shown in turn on the same display, so each also checks that whatever
+    // the last set left behind is cleared. The last two sets overlap, where later labels are drawn
+    // over earlier ones.
+    static const char *const label_sets[][LABEL_COUNT] = {
+        { "GCN",             "",         "MELEE"    },
+        { "GCN",             "RUMBLE",   "MELEE"    },
+        { "XINPUT",          nullptr,    "ULTIMATE" },
+        { nullptr,           "RUMBLE",   nullptr    },
+        { "A",               "B",        "C"        },
+        { "NINTENDO SWITCH", "RUMBLE",   "ULTIMATE" },
+        { "PROJECT M",       "12345678", "RIVALS"   },
+    };
+
+    InputState inputs;
+    for (size_t set = 0; set < sizeof(label_sets) / sizeof(label_sets[0]); set++) {
+        for (int i = 0; i < LABEL_COUNT; i++) {
+            display.SetLabel((DisplayLabel)i, label_sets[set][i]);
+        }
+        display.Update(inputs);
+
+        draw_labels_directly(label_sets[set], direct);
+        char message[32];
+        snprintf(message, sizeof(message), "label set %d", (int)set);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(direct, composited, BUFFER_SIZE, message);
+    }
+}
+
+void test_label_change_only_sends_its_tiles() {
+    init_panel();
+    InputDisplay display(&obd);
+    static const char *const labels[] = { "GCN", "RUMBLE", "MELEE" };
+    display.SetLabel(LABEL_LEFT, labels[LABEL_LEFT]);
+    display.SetLabel(LABEL_RIGHT, labels[LABEL_RIGHT]);
+
+    InputState inputs;
+    display.Update(inputs);
+    size_t sent = host::oled_data_bytes();
+
+    // RUMBLE covers columns 46 to 81, so at most tiles 2 to 5 change.
+    display.SetLabel(LABEL_CENTER, labels[LABEL_CENTER]);
+    display.Update(inputs);
+    TEST_ASSERT_GREATER_THAN(sent, host::oled_data_bytes());
+    TEST_ASSERT_LESS_OR_EQUAL(sent + 4 * INPUT_DISPLAY_TILE_WIDTH, host::oled_data_bytes());
+
+    uint8_t expected[BUFFER_SIZE];
+    uint8_t panel[BUFFER_SIZE];
+    draw_labels_directly(labels, expected);
+    read_panel(panel);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, panel, BUFFER_SIZE);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_dirty_tiles_match_full_redraw);
+    RUN_TEST(test_dirty_tiles_match_full_redraw_on_spi);
+    RUN_TEST(test_spi_runs_wait_for_each_transfer);
+    RUN_TEST(test_i2c_transfer_waits_for_shared_block);
+    RUN_TEST(test_abort_during_other_transfer_is_left_alone);
+    RUN_TEST(test_only_changed_tiles_are_sent);
+    RUN_TEST(test_circle_sprite_matches_ellipse);
+    RUN_TEST(test_square_sprite_matches_rectangle);
+    RUN_TEST(test_labels_match_direct_drawing);
+    RUN_TEST(test_label_change_only_sends_its_tiles);
+    return UNITY_END();
+}
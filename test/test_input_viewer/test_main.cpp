@@ -0,0 +1,91 @@
+#include "comms/B0XXInputViewer.hpp"
+#include "core/CommunicationBackend.hpp"
+#include "core/InputSource.hpp"
+#include "core/input_mask.hpp"
+#include "host.hpp"
+#include "modes/Melee20Button.hpp"
+
+#include <unity.h>
+
+// Reports whatever inputs the test sets.
+class HeldInputs : public InputSource {
+  public:
+    InputState held;
+
+    InputScanSpeed ScanSpeed() { return InputScanSpeed::FAST; }
+    void UpdateInputs(InputState &inputs) { inputs = held; }
+};
+
+// Runs the mode on every report, like a console backend would, without any console.
+class PrimaryBackend : public CommunicationBackend {
+  public:
+    static constexpr BackendInfo info = { BackendId::GAMECUBE, "TEST" };
+
+    PrimaryBackend(InputSource **input_sources, size_t input_source_count)
+        : CommunicationBackend(input_sources, input_source_count) {}
+    void SendReport() {
+        ScanInputs();
+        UpdateOutputs();
+    }
+    const BackendInfo &Info() { return info; }
+};
+
+static HeldInputs *held;
+static InputSource *input_sources[1];
+static PrimaryBackend *primary;
+
+void setUp() {
+    host::reset();
+    host::set_micros(1000000);
+    held = new HeldInputs();
+    input_sources[0] = held;
+    primary = new PrimaryBackend(input_sources, 1);
+    primary->SetGameMode(new Melee20Button(socd::SOCD_2IP_NO_REAC));
+}
+
+void tearDown() {
+    delete primary;
+    delete held;
+}
+
+// Sends one report with left then right held, which the mode's SOCD handling resolves to right.
+static void hold_left_and_right(B0XXInputViewer &viewer) {
+    held->held.left = true;
+    primary->SendReport();
+    held->held.right = true;
+    primary->SendReport();
+    TEST_ASSERT_FALSE(primary->GetInputs().left);
+
+    viewer.SendReport();
+}
+
+void test_binary_report_shows_inputs_before_socd() {
+    B0XXInputViewer viewer(nullptr, 0, primary, InputViewerProtocol::BINARY);
+    hold_left_and_right(viewer);
+
+    input_viewer_report_t report;
+    TEST_ASSERT_EQUAL(sizeof(report), host::serial_output((uint8_t *)&report, sizeof(report)));
+    TEST_ASSERT_EQUAL_HEX8(INPUT_VIEWER_BINARY_HEADER, report.header);
+    TEST_ASSERT_TRUE(report.buttons & (1 << input_mask::BIT_LEFT));
+    TEST_ASSERT_TRUE(report.buttons & (1 << input_mask::BIT_RIGHT));
+    // The stick is still what the mode output after SOCD.
+    TEST_ASSERT_GREATER_THAN(128, report.left_stick_x);
+}
+
+void test_ascii_report_shows_inputs_before_socd() {
+    B0XXInputViewer viewer(nullptr, 0, primary, InputViewerProtocol::ASCII);
+    hold_left_and_right(viewer);
+
+    uint8_t report[25];
+    TEST_ASSERT_EQUAL(sizeof(report), host::serial_output(report, sizeof(report)));
+    TEST_ASSERT_EQUAL('1', report[10]);
+    TEST_ASSERT_EQUAL('1', report[11]);
+    TEST_ASSERT_EQUAL('\n', report[24]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_binary_report_shows_inputs_before_socd);
+    RUN_TEST(test_ascii_report_shows_inputs_before_socd);
+    return UNITY_END();
+}
@@ -0,0 +1,160 @@
+#include "comms/ConsoleStandIn.hpp"
+#include "comms/GamecubeBackend.hpp"
+#include "comms/N64Backend.hpp"
+#include "core/InputSource.hpp"
+#include "core/input_mask.hpp"
+#include "host.hpp"
+#include "modes/FgcMode.hpp"
+#include "modes/Melee18Button.hpp"
+#include "modes/Melee20Button.hpp"
+#include "modes/ProjectM.hpp"
+#include "modes/RivalsOfAether.hpp"
+#include "modes/Ultimate.hpp"
+#include "modes/extra/DarkSouls.hpp"
+#include "modes/extra/HollowKnight.hpp"
+#include "modes/extra/MKWii.hpp"
+#include "modes/extra/MultiVersus.hpp"
+#include "modes/extra/RocketLeague.hpp"
+#include "modes/extra/SaltAndSanctuary.hpp"
+#include "modes/extra/ShovelKnight.hpp"
+#include "modes/extra/Ultimate2.hpp"
+
+#include <stdio.h>
+#include <unity.h>
+
+/*
+ * Runs every mode behind the GameCube and N64 backends against a stand-in console polling with
+ * jitter, and fails if any poll isn't answered in time. The real time the host spent answering
+ * each poll is printed per mode, as a rough comparison of the modes' costs.
+ */
+
+#define POLLS 5000
+
+// Presses a different pseudo-random combination of buttons on every scan.
+class RandomInputs : public InputSource {
+  public:
+    InputScanSpeed ScanSpeed() { return InputScanSpeed::FAST; }
+    void UpdateInputs(InputState &inputs) {
+        _state = _state * 1664525 + 1013904223;
+        input_mask::unpack(_state >> 7, inputs);
+    }
+
+  private:
+    uint32_t _state = 1;
+};
+
+// Returns a new instance of every controller mode in turn, then nullptr.
+static ControllerMode *create_mode(size_t index) {
+    switch (index) {
+        case 0:
+            return new Melee20Button(socd::SOCD_2IP_NO_REAC);
+        case 1:
+            return new Melee18Button(socd::SOCD_2IP_NO_REAC);
+        case 2:
+            return new ProjectM(socd::SOCD_2IP_NO_REAC);
+        case 3:
+            return new Ultimate(socd::SOCD_2IP);
+        case 4:
+            return new RivalsOfAether(socd::SOCD_2IP);
+        case 5:
+            return new FgcMode(socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL);
+        case 6:
+            return new DarkSouls(socd::SOCD_2IP);
+        case 7:
+            return new HollowKnight(socd::SOCD_2IP);
+        case 8:
+            return new MKWii(socd::SOCD_2IP);
+        case 9:
+            return new MultiVersus(socd::SOCD_2IP);
+        case 10:
+            return new RocketLeague(socd::SOCD_2IP);
+        case 11:
+            return new SaltAndSanctuary(socd::SOCD_2IP);
+        case 12:
+            return new ShovelKnight(socd::SOCD_2IP);
+        case 13:
+            return new Ultimate2(socd::SOCD_2IP);
+        default:
+            return nullptr;
+    }
+}
+
+static const console_timing_t timing = {
+    .poll_interval_us = 1000,
+    .jitter_us = 250,
+    .reply_timeout_us = 60,
+    .seed = 12345,
+};
+
+static RandomInputs *random_inputs;
+static InputSource *input_sources[1];
+
+void setUp() {
+    host::reset();
+    random_inputs = new RandomInputs();
+    input_sources[0] = random_inputs;
+}
+
+void tearDown() {
+    delete random_inputs;
+}
+
+static void check_stats(const char *backend, const char *mode, const console_stats_t &stats) {
+    char message[128];
+    snprintf(
+        message,
+        sizeof(message),
+        "%s %-16s reply %u-%uus, host %.0fns mean %.0fns max",
+        backend,
+        mode,
+        stats.min_reply_us,
+        stats.max_reply_us,
+        (double)stats.total_host_ns / (stats.replies + stats.late),
+        (double)stats.max_host_ns
+    );
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(POLLS, stats.polls, mode);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(POLLS, stats.replies, mode);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, stats.late, mode);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, stats.missed, mode);
+}
+
+void test_gamecube_every_mode() {
+    ControllerMode *mode;
+    for (size_t i = 0; (mode = create_mode(i)) != nullptr; i++) {
+        GamecubeConsoleStandIn *console = new GamecubeConsoleStandIn(timing);
+        GamecubeBackend backend(input_sources, 1, console);
+        backend.SetGameMode(mode);
+        for (size_t poll = 0; poll < POLLS; poll++) {
+            backend.SendReport();
+        }
+
+        console_stats_t stats;
+        console->GetStats(stats);
+        check_stats("GCN", mode->Info().name, stats);
+    }
+}
+
+void test_n64_every_mode() {
+    ControllerMode *mode;
+    for (size_t i = 0; (mode = create_mode(i)) != nullptr; i++) {
+        N64ConsoleStandIn *console = new N64ConsoleStandIn(timing);
+        N64Backend backend(input_sources, 1, console);
+        backend.SetGameMode(mode);
+        for (size_t poll = 0; poll < POLLS; poll++) {
+            backend.SendReport();
+        }
+
+        console_stats_t stats;
+        console->GetStats(stats);
+        check_stats("N64", mode->Info().name, stats);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_gamecube_every_mode);
+    RUN_TEST(test_n64_every_mode);
+    return UNITY_END();
+}
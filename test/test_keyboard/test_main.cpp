@@ -0,0 +1,132 @@
+#include "host.hpp"
+
+#include <TUKeyboard.hpp>
+#include <unity.h>
+
+#define KEY_A 0x04
+#define KEY_B 0x05
+#define KEY_LEFT_SHIFT 0xE1
+
+// Byte offsets into the captured report, which starts with the report ID.
+#define NKRO_MODIFIER 1
+#define NKRO_KEYS 2
+#define BOOT_KEYCODES 3
+
+static TUKeyboard *keyboard;
+
+static bool nkro_key_sent(uint8_t keycode) {
+    uint8_t report[64];
+    host::usb_last_report(report, sizeof(report));
+    return report[NKRO_KEYS + (keycode >> 3)] & (1 << (keycode & 0x07));
+}
+
+void setUp() {
+    host::reset();
+    keyboard = new TUKeyboard();
+}
+
+void tearDown() {
+    delete keyboard;
+}
+
+void test_unchanged_state_is_not_resent() {
+    TEST_ASSERT_TRUE(keyboard->sendState());
+    TEST_ASSERT_EQUAL(0, host::usb_reports_sent());
+
+    keyboard->press(KEY_A);
+    TEST_ASSERT_TRUE(keyboard->sendState());
+    TEST_ASSERT_TRUE(keyboard->sendState());
+    TEST_ASSERT_EQUAL(1, host::usb_reports_sent());
+}
+
+void test_busy_endpoint_does_not_block() {
+    host::set_usb_busy(-1);
+    keyboard->press(KEY_A);
+
+    uint32_t start = micros();
+    TEST_ASSERT_FALSE(keyboard->sendState());
+    TEST_ASSERT_EQUAL_UINT32(start, micros());
+    TEST_ASSERT_TRUE(keyboard->pending());
+    TEST_ASSERT_EQUAL(0, host::usb_reports_sent());
+}
+
+void test_changes_while_busy_are_coalesced() {
+    host::set_usb_busy(-1);
+    keyboard->press(KEY_A);
+    TEST_ASSERT_FALSE(keyboard->sendState());
+    keyboard->press(KEY_B);
+    keyboard->press(KEY_LEFT_SHIFT);
+    TEST_ASSERT_FALSE(keyboard->sendState());
+
+    // Once the endpoint frees up, everything goes out in a single report.
+    host::set_usb_busy(0);
+    TEST_ASSERT_TRUE(keyboard->sendState());
+    TEST_ASSERT_EQUAL(1, host::usb_reports_sent());
+    TEST_ASSERT_TRUE(nkro_key_sent(KEY_A));
+    TEST_ASSERT_TRUE(nkro_key_sent(KEY_B));
+
+    uint8_t report[64];
+    host::usb_last_report(report, sizeof(report));
+    TEST_ASSERT_EQUAL_HEX8(1 << (KEY_LEFT_SHIFT & 0x0F), report[NKRO_MODIFIER]);
+    TEST_ASSERT_FALSE(keyboard->pending());
+}
+
+void test_press_and_release_while_busy_sends_nothing() {
+    keyboard->press(KEY_A);
+    TEST_ASSERT_TRUE(keyboard->sendState());
+
+    host::set_usb_busy(-1);
+    keyboard->press(KEY_B);
+    keyboard->release(KEY_B);
+    TEST_ASSERT_FALSE(keyboard->pending());
+
+    host::set_usb_busy(0);
+    TEST_ASSERT_TRUE(keyboard->sendState());
+    TEST_ASSERT_EQUAL(1, host::usb_reports_sent());
+}
+
+void test_flush_waits_for_endpoint() {
+    host::set_usb_busy(3);
+    keyboard->press(KEY_A);
+    keyboard->flush();
+    TEST_ASSERT_EQUAL(1, host::usb_reports_sent());
+    TEST_ASSERT_TRUE(nkro_key_sent(KEY_A));
+    TEST_ASSERT_FALSE(keyboard->pending());
+}
+
+void test_boot_report_retries_seventh_key() {
+    TUKeyboard::registerDescriptor(false);
+
+    for (uint8_t keycode = KEY_A; keycode < KEY_A + 7; keycode++) {
+        keyboard->press(keycode);
+    }
+    TEST_ASSERT_TRUE(keyboard->sendState());
+    TEST_ASSERT_FALSE(keyboard->isPressed(KEY_A + 6));
+
+    uint8_t report[64];
+    host::usb_last_report(report, sizeof(report));
+    for (uint8_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_HEX8(KEY_A + i, report[BOOT_KEYCODES + i]);
+    }
+
+    // Freeing a slot lets the key that didn't fit through on the next report.
+    keyboard->release(KEY_A);
+    keyboard->press(KEY_A + 6);
+    TEST_ASSERT_TRUE(keyboard->sendState());
+    host::usb_last_report(report, sizeof(report));
+    TEST_ASSERT_EQUAL_HEX8(KEY_A + 6, report[BOOT_KEYCODES]);
+}
+
+int main() {
+    TUKeyboard::registerDescriptor(true);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_unchanged_state_is_not_resent);
+    RUN_TEST(test_busy_endpoint_does_not_block);
+    RUN_TEST(test_changes_while_busy_are_coalesced);
+    RUN_TEST(test_press_and_release_while_busy_sends_nothing);
+    RUN_TEST(test_flush_waits_for_endpoint);
+    // Switches every instance to the 6KRO report, so it has to run last.
+    RUN_TEST(test_boot_report_retries_seventh_key);
+    return UNITY_END();
+}
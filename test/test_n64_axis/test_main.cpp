@@ -0,0 +1,247 @@
+#include "comms/ConsoleStandIn.hpp"
+#include "comms/N64Backend.hpp"
+#include "core/InputSource.hpp"
+#include "host.hpp"
+#include "modes/FgcMode.hpp"
+#include "modes/Melee18Button.hpp"
+#include "modes/Melee20Button.hpp"
+#include "modes/ProjectM.hpp"
+#include "modes/RivalsOfAether.hpp"
+#include "modes/Ultimate.hpp"
+#include "modes/extra/DarkSouls.hpp"
+
+#include <unity.h>
+
+#define N64_FULL 80
+
+// Reports whatever inputs the test sets.
+class HeldInputs : public InputSource {
+  public:
+    InputState held;
+
+    InputScanSpeed ScanSpeed() { return InputScanSpeed::FAST; }
+    void UpdateInputs(InputState &inputs) { inputs = held; }
+};
+
+static HeldInputs *held;
+static InputSource *input_sources[1];
+
+void setUp() {
+    host::reset();
+    held = new HeldInputs();
+    input_sources[0] = held;
+}
+
+void tearDown() {
+    delete held;
+}
+
+// Every offset from neutral must land within rounding of the exact linear scale, and the map must
+// be symmetric around neutral.
+static void check_linear(ControllerMode &mode, int stick_range, int n64_range = N64_FULL) {
+    for (int offset = 0; offset <= 127; offset++) {
+        double exact = (double)offset * n64_range / stick_range;
+        if (exact > n64_range) {
+            exact = n64_range;
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.5, exact, mode.N64AxisX(128 + offset));
+        TEST_ASSERT_FLOAT_WITHIN(0.5, exact, mode.N64AxisY(128 + offset));
+        TEST_ASSERT_EQUAL_INT8(-mode.N64AxisX(128 + offset), mode.N64AxisX(128 - offset));
+        TEST_ASSERT_EQUAL_INT8(-mode.N64AxisY(128 + offset), mode.N64AxisY(128 - offset));
+    }
+}
+
+// Sends one report with the given buttons held and returns it.
+static const n64_report_t &press(
+    N64Backend &backend,
+    N64ConsoleStandIn *console,
+    InputState buttons
+) {
+    held->held = buttons;
+    backend.SendReport();
+    return console->LastReport();
+}
+
+// Checks where the mode's modifier coordinates land against the thresholds Super Smash Bros. reads
+// from the N64 stick. Mod Y vertical is a jump or crouch in some modes, and a tilt in others.
+static void check_smash_thresholds(ControllerMode *mode, bool mod_y_vertical_jumps) {
+    N64ConsoleStandIn *console = new N64ConsoleStandIn();
+    N64Backend backend(input_sources, 1, console);
+    backend.SetGameMode(mode);
+
+    InputState left;
+    left.left = true;
+    InputState down;
+    down.down = true;
+    InputState up;
+    up.up = true;
+
+    // Full deflection dashes, jumps and crouches.
+    TEST_ASSERT_LESS_OR_EQUAL(-N64_SSB_SMASH_MIN, press(backend, console, left).stick_x);
+    TEST_ASSERT_LESS_OR_EQUAL(-N64_SSB_JUMP_MIN, press(backend, console, down).stick_y);
+    TEST_ASSERT_GREATER_OR_EQUAL(N64_SSB_JUMP_MIN, press(backend, console, up).stick_y);
+
+    // Mod Y horizontal walks slowly.
+    InputState inputs = left;
+    inputs.mod_y = true;
+    int8_t x = press(backend, console, inputs).stick_x;
+    TEST_ASSERT_LESS_OR_EQUAL(-N64_SSB_DEADZONE, x);
+    TEST_ASSERT_GREATER_OR_EQUAL(-N64_SSB_SLOW_WALK_MAX, x);
+
+    // Mod X horizontal walks faster but doesn't dash.
+    inputs = left;
+    inputs.mod_x = true;
+    x = press(backend, console, inputs).stick_x;
+    TEST_ASSERT_LESS_THAN(-N64_SSB_SLOW_WALK_MAX, x);
+    TEST_ASSERT_GREATER_THAN(-N64_SSB_SMASH_MIN, x);
+
+    // Mod X vertical tilts without crouching or jumping.
+    inputs = down;
+    inputs.mod_x = true;
+    int8_t y = press(backend, console, inputs).stick_y;
+    TEST_ASSERT_LESS_OR_EQUAL(-N64_SSB_DEADZONE, y);
+    TEST_ASSERT_GREATER_THAN(-N64_SSB_JUMP_MIN, y);
+    inputs = up;
+    inputs.mod_x = true;
+    y = press(backend, console, inputs).stick_y;
+    TEST_ASSERT_GREATER_OR_EQUAL(N64_SSB_DEADZONE, y);
+    TEST_ASSERT_LESS_THAN(N64_SSB_JUMP_MIN, y);
+
+    inputs = up;
+    inputs.mod_y = true;
+    y = press(backend, console, inputs).stick_y;
+    if (mod_y_vertical_jumps) {
+        TEST_ASSERT_GREATER_OR_EQUAL(N64_SSB_JUMP_MIN, y);
+    } else {
+        TEST_ASSERT_GREATER_OR_EQUAL(N64_SSB_DEADZONE, y);
+        TEST_ASSERT_LESS_THAN(N64_SSB_JUMP_MIN, y);
+    }
+
+    // Full diagonals dash and jump or crouch.
+    inputs = left;
+    inputs.up = true;
+    TEST_ASSERT_LESS_OR_EQUAL(-N64_SSB_SMASH_MIN, press(backend, console, inputs).stick_x);
+    TEST_ASSERT_GREATER_OR_EQUAL(N64_SSB_JUMP_MIN, console->LastReport().stick_y);
+    inputs = left;
+    inputs.down = true;
+    TEST_ASSERT_LESS_OR_EQUAL(-N64_SSB_SMASH_MIN, press(backend, console, inputs).stick_x);
+    TEST_ASSERT_LESS_OR_EQUAL(-N64_SSB_JUMP_MIN, console->LastReport().stick_y);
+
+    // Nothing pressed is neutral.
+    TEST_ASSERT_EQUAL_INT8(0, press(backend, console, InputState()).stick_x);
+    TEST_ASSERT_EQUAL_INT8(0, console->LastReport().stick_y);
+}
+
+void test_melee_20_button_lands_on_smash_thresholds() {
+    check_smash_thresholds(new Melee20Button(socd::SOCD_2IP_NO_REAC), true);
+}
+
+void test_melee_18_button_lands_on_smash_thresholds() {
+    check_smash_thresholds(new Melee18Button(socd::SOCD_2IP_NO_REAC), true);
+}
+
+void test_project_m_lands_on_smash_thresholds() {
+    check_smash_thresholds(new ProjectM(socd::SOCD_2IP_NO_REAC), true);
+}
+
+void test_ultimate_lands_on_smash_thresholds() {
+    check_smash_thresholds(new Ultimate(socd::SOCD_2IP), false);
+}
+
+void test_table_points_are_interpolated() {
+    Melee20Button mode(socd::SOCD_2IP_NO_REAC);
+    mode.InitN64AxisMap();
+
+    // Points land exactly, and values in between are interpolated and rounded.
+    TEST_ASSERT_EQUAL_INT8(18, mode.N64AxisX(128 + 27));
+    TEST_ASSERT_EQUAL_INT8(44, mode.N64AxisX(128 + 53));
+    TEST_ASSERT_EQUAL_INT8(31, mode.N64AxisX(128 + 40));
+    TEST_ASSERT_EQUAL_INT8(36, mode.N64AxisY(128 + 43));
+    TEST_ASSERT_EQUAL_INT8(-36, mode.N64AxisY(128 - 43));
+    TEST_ASSERT_EQUAL_INT8(N64_FULL, mode.N64AxisX(208));
+    TEST_ASSERT_EQUAL_INT8(-N64_FULL, mode.N64AxisY(48));
+
+    // The map never decreases, and anything beyond full deflection is clamped.
+    for (int value = 129; value <= 255; value++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(mode.N64AxisX(value - 1), mode.N64AxisX(value));
+        TEST_ASSERT_GREATER_OR_EQUAL(mode.N64AxisY(value - 1), mode.N64AxisY(value));
+    }
+    TEST_ASSERT_EQUAL_INT8(N64_FULL, mode.N64AxisX(255));
+    TEST_ASSERT_EQUAL_INT8(-N64_FULL, mode.N64AxisY(0));
+}
+
+void test_modes_without_table_scale_linearly() {
+    RivalsOfAether mode(socd::SOCD_2IP);
+    mode.InitN64AxisMap();
+    check_linear(mode, 100);
+
+    // Rounding thresholds at 0.8 N64 units per step.
+    TEST_ASSERT_EQUAL_INT8(1, mode.N64AxisX(128 + 1));
+    TEST_ASSERT_EQUAL_INT8(2, mode.N64AxisX(128 + 3));
+    TEST_ASSERT_EQUAL_INT8(40, mode.N64AxisX(128 + 50));
+}
+
+void test_full_range_clamps_to_n64() {
+    DarkSouls mode(socd::SOCD_2IP);
+    mode.InitN64AxisMap();
+    check_linear(mode, 127);
+    TEST_ASSERT_EQUAL_INT8(N64_FULL, mode.N64AxisX(255));
+    TEST_ASSERT_EQUAL_INT8(-N64_FULL, mode.N64AxisY(0));
+}
+
+void test_modes_without_directions_send_raw_offset() {
+    FgcMode mode(socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL);
+    mode.InitN64AxisMap();
+    TEST_ASSERT_EQUAL_INT8(100, mode.N64AxisX(228));
+    TEST_ASSERT_EQUAL_INT8(-128, mode.N64AxisY(0));
+}
+
+void test_stick_range_moves_full_deflection_only() {
+    Melee20Button *mode = new Melee20Button(socd::SOCD_2IP_NO_REAC);
+    N64ConsoleStandIn *console = new N64ConsoleStandIn();
+    N64Backend backend(input_sources, 1, console);
+    backend.SetGameMode(mode);
+    backend.SetStickRange(85);
+
+    InputState inputs;
+    inputs.left = true;
+    TEST_ASSERT_EQUAL_INT8(-85, press(backend, console, inputs).stick_x);
+
+    // Modifier coordinates stay on the same thresholds.
+    inputs.mod_x = true;
+    TEST_ASSERT_EQUAL_INT8(-44, press(backend, console, inputs).stick_x);
+
+    // The range also applies to modes set afterwards, and to linear scaling.
+    RivalsOfAether *rivals = new RivalsOfAether(socd::SOCD_2IP);
+    backend.SetGameMode(rivals);
+    check_linear(*rivals, 100, 85);
+}
+
+void test_map_is_ready_before_first_poll() {
+    Ultimate *mode = new Ultimate(socd::SOCD_2IP);
+    N64ConsoleStandIn *console = new N64ConsoleStandIn();
+    N64Backend backend(input_sources, 1, console);
+    backend.SetGameMode(mode);
+    TEST_ASSERT_EQUAL_INT8(N64_FULL, mode->N64AxisX(228));
+
+    InputState inputs;
+    inputs.left = true;
+    inputs.up = true;
+    TEST_ASSERT_EQUAL_INT8(-N64_FULL, press(backend, console, inputs).stick_x);
+    TEST_ASSERT_EQUAL_INT8(N64_FULL, console->LastReport().stick_y);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_melee_20_button_lands_on_smash_thresholds);
+    RUN_TEST(test_melee_18_button_lands_on_smash_thresholds);
+    RUN_TEST(test_project_m_lands_on_smash_thresholds);
+    RUN_TEST(test_ultimate_lands_on_smash_thresholds);
+    RUN_TEST(test_table_points_are_interpolated);
+    RUN_TEST(test_modes_without_table_scale_linearly);
+    RUN_TEST(test_full_range_clamps_to_n64);
+    RUN_TEST(test_modes_without_directions_send_raw_offset);
+    RUN_TEST(test_stick_range_moves_full_deflection_only);
+    RUN_TEST(test_map_is_ready_before_first_poll);
+    return UNITY_END();
+}
@@ -0,0 +1,169 @@
+#include "core/state.hpp"
+#include "host.hpp"
+#include "input/NunchukInput.hpp"
+#include "persistent_storage.hpp"
+
+#include <string.h>
+#include <unity.h>
+
+#define DISPLAY_I2C_ADDR 0x3C
+
+void setUp() {
+    host::reset();
+}
+
+void tearDown() {}
+
+void test_report_sets_stick_and_connected() {
+    const uint8_t report[NUNCHUK_REPORT_SIZE] = { 37, 219, 0, 0, 0, 0xFF };
+    InputState inputs;
+    NunchukInput::DecodeReport(report, inputs);
+
+    TEST_ASSERT_TRUE(inputs.nunchuk_connected);
+    TEST_ASSERT_EQUAL_UINT8(37, inputs.nunchuk_x);
+    TEST_ASSERT_EQUAL_UINT8(219, inputs.nunchuk_y);
+}
+
+void test_buttons_are_active_low() {
+    // Byte 5 bit 0 is Z and bit 1 is C, both cleared while pressed.
+    const struct {
+        uint8_t byte5;
+        bool c;
+        bool z;
+    } cases[] = {
+        { 0x03, false, false },
+        { 0x02, false, true },
+        { 0x01, true,  false },
+        { 0x00, true,  true },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const uint8_t report[NUNCHUK_REPORT_SIZE] = { 128, 128, 0, 0, 0, cases[i].byte5 };
+        InputState inputs;
+        NunchukInput::DecodeReport(report, inputs);
+        TEST_ASSERT_EQUAL(cases[i].c, inputs.nunchuk_c);
+        TEST_ASSERT_EQUAL(cases[i].z, inputs.nunchuk_z);
+    }
+}
+
+void test_accelerometer_bits_do_not_affect_buttons() {
+    // The upper six bits of byte 5 are the low bits of the accelerometer axes.
+    const uint8_t report[NUNCHUK_REPORT_SIZE] = { 128, 128, 0x80, 0x80, 0x80, 0xFC | 0x02 };
+    InputState inputs;
+    NunchukInput::DecodeReport(report, inputs);
+
+    TEST_ASSERT_FALSE(inputs.nunchuk_c);
+    TEST_ASSERT_TRUE(inputs.nunchuk_z);
+    TEST_ASSERT_EQUAL_UINT8(128, inputs.nunchuk_x);
+    TEST_ASSERT_EQUAL_UINT8(128, inputs.nunchuk_y);
+}
+
+void test_missing_nunchuk_leaves_inputs_untouched() {
+    NunchukInput nunchuk;
+    InputState inputs;
+    InputState before = inputs;
+    nunchuk.UpdateInputs(inputs);
+
+    TEST_ASSERT_FALSE(inputs.nunchuk_connected);
+    TEST_ASSERT_EQUAL_MEMORY(&before, &inputs, sizeof(InputState));
+}
+
+void test_i2c_block_follows_wire() {
+    TEST_ASSERT_EQUAL_PTR(i2c0, NunchukInput::I2cBlock(Wire));
+    TEST_ASSERT_EQUAL_PTR(i2c1, NunchukInput::I2cBlock(Wire1));
+}
+
+// A Nunchuk whose reports are fed in by the test rather than read over I2C.
+class FedNunchuk : public NunchukInput {
+  public:
+    FedNunchuk() {
+        _calibration = new StickCalibration();
+        _calibration->StartCapture();
+    }
+
+    void Feed(uint8_t x, uint8_t y, bool c, bool z) {
+        InputState inputs;
+        inputs.nunchuk_x = x;
+        inputs.nunchuk_y = y;
+        UpdateCalibration(inputs, c, z);
+    }
+};
+
+void test_confirmed_calibration_is_written_straight_away() {
+    FedNunchuk nunchuk;
+
+    // C and Z are still held from starting the capture, then released while the stick is moved.
+    nunchuk.Feed(130, 126, true, true);
+    nunchuk.Feed(130, 126, false, false);
+    nunchuk.Feed(20, 126, false, false);
+    nunchuk.Feed(240, 126, false, false);
+    nunchuk.Feed(130, 30, false, false);
+    nunchuk.Feed(130, 220, false, false);
+    stick_calibration_t stored;
+    TEST_ASSERT_FALSE(
+        persistent_storage::read(STORAGE_NUNCHUK_CALIBRATION_ADDR, 0xCA, &stored, sizeof(stored))
+    );
+
+    // Pressing both again saves it, without waiting for anything else to commit it.
+    nunchuk.Feed(130, 126, true, true);
+    TEST_ASSERT_FALSE(persistent_storage::staged());
+    TEST_ASSERT_TRUE(
+        persistent_storage::read(STORAGE_NUNCHUK_CALIBRATION_ADDR, 0xCA, &stored, sizeof(stored))
+    );
+    TEST_ASSERT_EQUAL_UINT8(130, stored.center_x);
+    TEST_ASSERT_EQUAL_UINT8(126, stored.center_y);
+    TEST_ASSERT_EQUAL_UINT8(20, stored.min_x);
+    TEST_ASSERT_EQUAL_UINT8(240, stored.max_x);
+    TEST_ASSERT_EQUAL_UINT8(30, stored.min_y);
+    TEST_ASSERT_EQUAL_UINT8(220, stored.max_y);
+}
+
+// A Nunchuk that answered the handshake, so that UpdateInputs() drives the I2C block.
+class WiredNunchuk : public NunchukInput {
+  public:
+    WiredNunchuk() {
+        _nunchuk = new ArduinoNunchuk(Wire);
+        _i2c = i2c0;
+        _calibration = new StickCalibration();
+    }
+
+    bool Reading() { return _state == TransferState::READING; }
+};
+
+void test_waits_for_display_to_finish_with_shared_block() {
+    WiredNunchuk nunchuk;
+    InputState inputs;
+    host::advance_micros(1000);
+
+    // The display is still sending a frame on the same block.
+    i2c0->hw->tar = DISPLAY_I2C_ADDR;
+    i2c0->hw->status = I2C_IC_STATUS_ACTIVITY_BITS;
+    nunchuk.UpdateInputs(inputs);
+    TEST_ASSERT_FALSE(nunchuk.Reading());
+    TEST_ASSERT_EQUAL_HEX32(DISPLAY_I2C_ADDR, i2c0->hw->tar);
+
+    // A failed display transfer is left for the display to clear, and holds the Nunchuk back too.
+    i2c0->hw->status = 0;
+    i2c0->hw->raw_intr_stat = I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+    nunchuk.UpdateInputs(inputs);
+    TEST_ASSERT_FALSE(nunchuk.Reading());
+
+    // Once the block is free, it is pointed back at the Nunchuk before the read starts.
+    i2c0->hw->raw_intr_stat = 0;
+    nunchuk.UpdateInputs(inputs);
+    TEST_ASSERT_TRUE(nunchuk.Reading());
+    TEST_ASSERT_EQUAL_HEX32(NUNCHUK_I2C_ADDR, i2c0->hw->tar);
+    TEST_ASSERT_EQUAL_UINT32(1, i2c0->hw->enable);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_report_sets_stick_and_connected);
+    RUN_TEST(test_buttons_are_active_low);
+    RUN_TEST(test_accelerometer_bits_do_not_affect_buttons);
+    RUN_TEST(test_missing_nunchuk_leaves_inputs_untouched);
+    RUN_TEST(test_i2c_block_follows_wire);
+    RUN_TEST(test_confirmed_calibration_is_written_straight_away);
+    RUN_TEST(test_waits_for_display_to_finish_with_shared_block);
+    return UNITY_END();
+}
@@ -0,0 +1,77 @@
+#include "core/PollStats.hpp"
+#include "host.hpp"
+#include "persistent_storage.hpp"
+
+#include <unity.h>
+
+#define MAGIC 0x5A
+
+void setUp() {
+    host::reset();
+}
+
+void tearDown() {}
+
+void test_staged_record_is_only_written_on_commit() {
+    const uint8_t data[4] = { 1, 2, 3, 4 };
+    TEST_ASSERT_TRUE(persistent_storage::stage(STORAGE_CUSTOM_LAYOUT_ADDR, MAGIC, data, 4));
+    TEST_ASSERT_TRUE(persistent_storage::staged());
+
+    uint8_t read[4];
+    TEST_ASSERT_FALSE(persistent_storage::read(STORAGE_CUSTOM_LAYOUT_ADDR, MAGIC, read, 4));
+    TEST_ASSERT_EQUAL(0, host::storage_commits());
+
+    persistent_storage::commit_staged();
+    TEST_ASSERT_FALSE(persistent_storage::staged());
+    TEST_ASSERT_EQUAL(1, host::storage_commits());
+    TEST_ASSERT_TRUE(persistent_storage::read(STORAGE_CUSTOM_LAYOUT_ADDR, MAGIC, read, 4));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, read, 4);
+}
+
+void test_restaging_replaces_record() {
+    const uint8_t first[2] = { 1, 2 };
+    const uint8_t second[2] = { 3, 4 };
+    persistent_storage::stage(STORAGE_NUNCHUK_CALIBRATION_ADDR, MAGIC, first, 2);
+    persistent_storage::stage(STORAGE_NUNCHUK_CALIBRATION_ADDR, MAGIC, second, 2);
+    persistent_storage::commit_staged();
+
+    uint8_t read[2];
+    persistent_storage::read(STORAGE_NUNCHUK_CALIBRATION_ADDR, MAGIC, read, 2);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(second, read, 2);
+}
+
+void test_records_are_committed_together() {
+    const uint8_t data = 7;
+    persistent_storage::stage(STORAGE_CONSOLE_HINT_ADDR, MAGIC, &data, 1);
+    persistent_storage::stage(STORAGE_NUNCHUK_CALIBRATION_ADDR, MAGIC, &data, 1);
+    persistent_storage::stage(STORAGE_CUSTOM_LAYOUT_ADDR, MAGIC, &data, 1);
+    persistent_storage::commit_staged();
+    TEST_ASSERT_EQUAL(1, host::storage_commits());
+
+    // Staging records identical to the stored ones doesn't need another commit.
+    persistent_storage::stage(STORAGE_CONSOLE_HINT_ADDR, MAGIC, &data, 1);
+    persistent_storage::commit_staged();
+    TEST_ASSERT_EQUAL(1, host::storage_commits());
+}
+
+void test_poll_stats_idle_after_polls_stop() {
+    PollStats stats;
+    host::set_micros(500000);
+    stats.PollStarted();
+    stats.ReplySent();
+    TEST_ASSERT_FALSE(stats.Idle(100000));
+
+    host::advance_micros(99999);
+    TEST_ASSERT_FALSE(stats.Idle(100000));
+    host::advance_micros(1);
+    TEST_ASSERT_TRUE(stats.Idle(100000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_staged_record_is_only_written_on_commit);
+    RUN_TEST(test_restaging_replaces_record);
+    RUN_TEST(test_records_are_committed_together);
+    RUN_TEST(test_poll_stats_idle_after_polls_stop);
+    return UNITY_END();
+}
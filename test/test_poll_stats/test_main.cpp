@@ -0,0 +1,136 @@
+#include "core/PollStats.hpp"
+#include "host.hpp"
+
+#include <unity.h>
+
+void setUp() {
+    host::reset();
+}
+
+void tearDown() {}
+
+// Answers one poll the way a backend does, with the report ready ready_us after the poll and the
+// reply sent reply_us after it. A negative ready_us means the backend doesn't report it.
+static void answer_poll(PollStats &stats, int ready_us, uint32_t reply_us) {
+    stats.PollStarted();
+    if (ready_us >= 0) {
+        host::advance_micros(ready_us);
+        stats.ReportReady();
+        host::advance_micros(reply_us - ready_us);
+    } else {
+        host::advance_micros(reply_us);
+    }
+    stats.ReplySent();
+}
+
+// Polls at 1000Hz for one whole window, with latencies cycling from 40us to 119us. A window is
+// only published by the first reply after it ends, so finish with one more poll with a latency in
+// the same range.
+static void poll_for_window(PollStats &stats, int ready_before_reply_us) {
+    for (int i = 0; i <= 1000; i++) {
+        uint32_t latency_us = 40 + i % 80;
+        int ready_us = ready_before_reply_us < 0 ? -1 : latency_us - ready_before_reply_us;
+        answer_poll(stats, ready_us, latency_us);
+        if (i < 1000) {
+            host::advance_micros(1000 - latency_us);
+        }
+    }
+}
+
+void test_nothing_published_before_first_window() {
+    // The first window starts at boot, which is when the simulated clock starts.
+    PollStats stats;
+    answer_poll(stats, -1, 50);
+
+    poll_stats_t result;
+    stats.Get(result);
+    TEST_ASSERT_EQUAL_UINT32(0, result.poll_rate);
+    TEST_ASSERT_EQUAL_UINT32(POLL_STATS_NO_SAMPLES, result.min_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(POLL_STATS_NO_SAMPLES, result.max_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(POLL_STATS_NO_SAMPLES, result.min_slack_us);
+}
+
+void test_window_measures_rate_latency_and_slack() {
+    PollStats stats;
+    poll_for_window(stats, 30);
+
+    poll_stats_t result;
+    stats.Get(result);
+    TEST_ASSERT_UINT32_WITHIN(1, 1000, result.poll_rate);
+    TEST_ASSERT_EQUAL_UINT32(40, result.min_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(119, result.max_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(30, result.min_slack_us);
+}
+
+void test_slack_not_measured_without_report_ready() {
+    PollStats stats;
+    poll_for_window(stats, -1);
+
+    poll_stats_t result;
+    stats.Get(result);
+    TEST_ASSERT_UINT32_WITHIN(1, 1000, result.poll_rate);
+    TEST_ASSERT_EQUAL_UINT32(POLL_STATS_NO_SAMPLES, result.min_slack_us);
+}
+
+void test_each_window_starts_over() {
+    PollStats stats;
+    poll_for_window(stats, 10);
+
+    // A slower second window with steady latency doesn't keep the first window's extremes.
+    for (int i = 0; i < 125; i++) {
+        host::advance_micros(8000 - 100);
+        answer_poll(stats, 60, 100);
+    }
+
+    poll_stats_t result;
+    stats.Get(result);
+    TEST_ASSERT_UINT32_WITHIN(1, 125, result.poll_rate);
+    TEST_ASSERT_EQUAL_UINT32(100, result.min_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(100, result.max_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(40, result.min_slack_us);
+}
+
+void test_stale_window_is_cleared_once_polling_stops() {
+    PollStats stats;
+    poll_for_window(stats, -1);
+    stats.PollSkipped();
+
+    host::advance_micros(2 * POLL_STATS_WINDOW_US);
+    poll_stats_t result;
+    stats.Get(result);
+    TEST_ASSERT_UINT32_WITHIN(1, 1000, result.poll_rate);
+
+    host::advance_micros(POLL_STATS_WINDOW_US);
+    stats.Get(result);
+    TEST_ASSERT_EQUAL_UINT32(0, result.poll_rate);
+    TEST_ASSERT_EQUAL_UINT32(POLL_STATS_NO_SAMPLES, result.min_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(POLL_STATS_NO_SAMPLES, result.max_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(POLL_STATS_NO_SAMPLES, result.min_slack_us);
+    // Skipped polls count since boot, so they are kept.
+    TEST_ASSERT_EQUAL_UINT32(1, result.skipped_polls);
+}
+
+void test_skipped_polls_accumulate() {
+    PollStats stats;
+    for (int i = 0; i < 3; i++) {
+        stats.PollStarted();
+        stats.PollSkipped();
+    }
+    poll_for_window(stats, -1);
+    stats.PollSkipped();
+
+    poll_stats_t result;
+    stats.Get(result);
+    TEST_ASSERT_EQUAL_UINT32(4, result.skipped_polls);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_published_before_first_window);
+    RUN_TEST(test_window_measures_rate_latency_and_slack);
+    RUN_TEST(test_slack_not_measured_without_report_ready);
+    RUN_TEST(test_each_window_starts_over);
+    RUN_TEST(test_stale_window_is_cleared_once_polling_stops);
+    RUN_TEST(test_skipped_polls_accumulate);
+    return UNITY_END();
+}
@@ -0,0 +1,175 @@
+#include "core/TraceRecorder.hpp"
+#include "core/input_mask.hpp"
+#include "host.hpp"
+#include "input/ReplayInput.hpp"
+#include "modes/Melee20Button.hpp"
+#include "trace_diff.hpp"
+
+#include <unity.h>
+
+#define SCRIPT_LENGTH 7
+#define FRAME_SIZE (sizeof(trace_record_t) + 2)
+
+static trace_record_t records[SCRIPT_LENGTH];
+static size_t record_count;
+
+// The inputs held on each poll of the recording.
+static void script_inputs(size_t poll, InputState &inputs) {
+    inputs = InputState();
+    switch (poll) {
+        case 1:
+            inputs.left = true;
+            break;
+        case 2:
+            // Resolved to right by 2IP SOCD, but to neutral by neutral SOCD.
+            inputs.left = true;
+            inputs.right = true;
+            break;
+        case 3:
+            inputs.right = true;
+            break;
+        case 4:
+            inputs.a = true;
+#ifdef ANALOG_INPUT_STATE
+            inputs.gcc_connected = true;
+            inputs.gcc_b = true;
+            inputs.analog_trigger_l = 100;
+            inputs.analog_cstick_x = 200;
+#endif
+            break;
+        case 5:
+            inputs.nunchuk_connected = true;
+            inputs.nunchuk_x = (int8_t)200;
+            inputs.nunchuk_y = (int8_t)60;
+            break;
+    }
+}
+
+// Records the script being played through a mode, the same way CommunicationBackend does, and
+// decodes the frames streamed out over serial.
+static void record_script(ControllerMode &mode) {
+    TraceRecorder recorder;
+    for (size_t poll = 0; poll < SCRIPT_LENGTH; poll++) {
+        InputState inputs;
+        OutputState outputs;
+        script_inputs(poll, inputs);
+        host::advance_micros(1000);
+        uint32_t raw_inputs = input_mask::pack(inputs);
+        mode.UpdateOutputs(inputs, outputs);
+        recorder.Record(raw_inputs, inputs, outputs);
+        recorder.Drain();
+    }
+
+    uint8_t stream[SCRIPT_LENGTH * FRAME_SIZE];
+    size_t stream_len = host::serial_output(stream, sizeof(stream));
+    TEST_ASSERT_EQUAL(sizeof(stream), stream_len);
+
+    record_count = 0;
+    for (size_t offset = 0; offset < stream_len; offset += FRAME_SIZE) {
+        const uint8_t *frame = &stream[offset];
+        TEST_ASSERT_EQUAL_HEX8(TRACE_FRAME_HEADER, frame[0]);
+        uint8_t checksum = 0;
+        for (size_t i = 1; i < FRAME_SIZE - 1; i++) {
+            checksum ^= frame[i];
+        }
+        TEST_ASSERT_EQUAL_HEX8(checksum, frame[FRAME_SIZE - 1]);
+        memcpy(&records[record_count++], &frame[1], sizeof(trace_record_t));
+    }
+}
+
+void setUp() {
+    host::reset();
+    Melee20Button mode(socd::SOCD_2IP_NO_REAC);
+    record_script(mode);
+}
+
+void tearDown() {}
+
+void test_input_mask_round_trip() {
+    const uint32_t patterns[] = { 0x0155AAAA, 0x00AA5555 };
+    for (uint32_t pattern : patterns) {
+        uint32_t mask = pattern & ((1u << input_mask::BIT_COUNT) - 1);
+        InputState inputs;
+        input_mask::unpack(mask, inputs);
+        TEST_ASSERT_EQUAL_HEX32(mask, input_mask::pack(inputs));
+#ifdef ANALOG_INPUT_STATE
+        uint16_t passthrough = pattern & ((1u << input_mask::GCC_BIT_COUNT) - 1);
+        input_mask::unpack_passthrough(passthrough, inputs);
+        TEST_ASSERT_EQUAL_HEX32(passthrough, input_mask::pack_passthrough(inputs));
+#endif
+    }
+}
+
+void test_recording_keeps_every_input() {
+    TEST_ASSERT_EQUAL(SCRIPT_LENGTH, record_count);
+    for (size_t i = 0; i < record_count; i++) {
+        TEST_ASSERT_EQUAL_UINT16(i, records[i].sequence);
+    }
+
+    // SOCD resolution must not leak into the recorded inputs.
+    TEST_ASSERT_EQUAL_HEX32(
+        (1 << input_mask::BIT_LEFT) | (1 << input_mask::BIT_RIGHT),
+        records[2].inputs
+    );
+
+    InputState inputs;
+#ifdef ANALOG_INPUT_STATE
+    TraceRecorder::UnpackInputs(records[4], inputs);
+    TEST_ASSERT_TRUE(inputs.gcc_connected);
+    TEST_ASSERT_TRUE(inputs.gcc_b);
+    TEST_ASSERT_EQUAL_UINT8(100, inputs.analog_trigger_l);
+    TEST_ASSERT_EQUAL_UINT8(200, inputs.analog_cstick_x);
+#endif
+
+    TraceRecorder::UnpackInputs(records[5], inputs);
+    TEST_ASSERT_EQUAL_INT8(200, inputs.nunchuk_x);
+    TEST_ASSERT_EQUAL_INT8(60, inputs.nunchuk_y);
+}
+
+void test_replay_matches_recording() {
+    Melee20Button mode(socd::SOCD_2IP_NO_REAC);
+    TEST_ASSERT_EQUAL(0, trace_diff(mode, records, record_count));
+}
+
+void test_replay_catches_socd_change() {
+    Melee20Button mode(socd::SOCD_NEUTRAL);
+    trace_mismatch_t mismatches[SCRIPT_LENGTH];
+    size_t count = trace_diff(mode, records, record_count, mismatches, SCRIPT_LENGTH);
+
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_EQUAL(2, mismatches[0].index);
+    TEST_ASSERT_GREATER_THAN(128, mismatches[0].expected.leftStickX);
+    TEST_ASSERT_EQUAL_UINT8(128, mismatches[0].actual.leftStickX);
+}
+
+#ifdef ANALOG_INPUT_STATE
+void test_replay_needs_analog_inputs() {
+    // A trace that only kept the digital inputs can't reproduce the passthrough outputs.
+    trace_record_t digital_only[SCRIPT_LENGTH];
+    memcpy(digital_only, records, sizeof(digital_only));
+    for (trace_record_t &record : digital_only) {
+        record.passthrough = 0;
+        record.analog_cstick_x = 128;
+        record.analog_trigger_l = 0;
+    }
+
+    Melee20Button mode(socd::SOCD_2IP_NO_REAC);
+    trace_mismatch_t mismatch;
+    TEST_ASSERT_EQUAL(1, trace_diff(mode, digital_only, record_count, &mismatch, 1));
+    TEST_ASSERT_EQUAL(4, mismatch.index);
+    TEST_ASSERT_TRUE(mismatch.expected.b);
+    TEST_ASSERT_FALSE(mismatch.actual.b);
+}
+#endif
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_input_mask_round_trip);
+    RUN_TEST(test_recording_keeps_every_input);
+    RUN_TEST(test_replay_matches_recording);
+    RUN_TEST(test_replay_catches_socd_change);
+#ifdef ANALOG_INPUT_STATE
+    RUN_TEST(test_replay_needs_analog_inputs);
+#endif
+    return UNITY_END();
+}
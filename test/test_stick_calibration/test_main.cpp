@@ -0,0 +1,157 @@
+#include "core/StickCalibration.hpp"
+#include "host.hpp"
+
+#include <math.h>
+#include <unity.h>
+
+#define RANGE STICK_CALIBRATION_RANGE
+
+void setUp() {
+    host::reset();
+}
+
+void tearDown() {}
+
+void test_response_is_zero_inside_deadzone() {
+    stick_calibration_t params;
+    params.deadzone = 10;
+    params.anti_deadzone = 20;
+
+    TEST_ASSERT_EQUAL_FLOAT(0, StickCalibration::Response(0, params));
+    TEST_ASSERT_EQUAL_FLOAT(0, StickCalibration::Response(10, params));
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 20, StickCalibration::Response(10.01, params));
+}
+
+void test_response_reaches_range_at_edge() {
+    stick_calibration_t params;
+    params.deadzone = 10;
+    params.anti_deadzone = 20;
+    params.curve = 25;
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001, RANGE, StickCalibration::Response(RANGE, params));
+    // Beyond the edge, e.g. on a diagonal, the response stays at the range.
+    TEST_ASSERT_FLOAT_WITHIN(0.001, RANGE, StickCalibration::Response(RANGE * 1.4f, params));
+}
+
+void test_linear_response() {
+    stick_calibration_t params;
+    params.deadzone = 0;
+
+    for (int distance = 0; distance <= RANGE; distance++) {
+        TEST_ASSERT_FLOAT_WITHIN(0.001, distance, StickCalibration::Response(distance, params));
+    }
+}
+
+void test_curve_is_a_power_of_distance_past_deadzone() {
+    stick_calibration_t params;
+    params.deadzone = 7;
+    params.anti_deadzone = 15;
+    params.curve = 20;
+
+    for (int distance = 8; distance <= RANGE; distance++) {
+        float t = (distance - 7.0f) / (RANGE - 7.0f);
+        float expected = 15 + t * t * (RANGE - 15);
+        TEST_ASSERT_FLOAT_WITHIN(0.001, expected, StickCalibration::Response(distance, params));
+    }
+}
+
+void test_response_never_decreases() {
+    const uint8_t curves[] = { 5, 10, 15, 30 };
+    for (size_t i = 0; i < sizeof(curves); i++) {
+        stick_calibration_t params;
+        params.curve = curves[i];
+        params.anti_deadzone = 12;
+
+        float last = 0;
+        for (float distance = 0; distance <= RANGE; distance += 0.25f) {
+            float response = StickCalibration::Response(distance, params);
+            TEST_ASSERT_TRUE(response >= last);
+            last = response;
+        }
+    }
+}
+
+void test_apply_matches_response_along_axes() {
+    stick_calibration_t params;
+    params.center_x = 130;
+    params.center_y = 126;
+    params.min_x = 30;
+    params.max_x = 230;
+    params.min_y = 26;
+    params.max_y = 226;
+    params.deadzone = 6;
+    params.curve = 15;
+    StickCalibration calibration(params);
+
+    for (int offset = -100; offset <= 100; offset++) {
+        uint8_t x = params.center_x + offset;
+        uint8_t y = params.center_y;
+        calibration.Apply(x, y);
+
+        // Each raw step is 1.27 calibrated units, and the radial table shares entries between
+        // nearby distances, so allow a couple of units either way.
+        int distance = abs(offset) * RANGE / 100;
+        float expected = StickCalibration::Response(distance, params);
+        TEST_ASSERT_INT_WITHIN(2, 128 + (offset < 0 ? -expected : expected), x);
+        TEST_ASSERT_EQUAL_UINT8(128, y);
+    }
+}
+
+void test_apply_keeps_output_in_range() {
+    stick_calibration_t params;
+    params.anti_deadzone = 30;
+    StickCalibration calibration(params);
+
+    for (int raw_x = 0; raw_x < 256; raw_x += 5) {
+        for (int raw_y = 0; raw_y < 256; raw_y += 5) {
+            uint8_t x = raw_x;
+            uint8_t y = raw_y;
+            calibration.Apply(x, y);
+            TEST_ASSERT_INT_WITHIN(RANGE, 128, x);
+            TEST_ASSERT_INT_WITHIN(RANGE, 128, y);
+        }
+    }
+}
+
+void test_capture_takes_center_and_range_from_samples() {
+    StickCalibration calibration;
+    calibration.StartCapture();
+    calibration.CaptureSample(120, 135);
+    calibration.CaptureSample(40, 200);
+    calibration.CaptureSample(210, 60);
+    calibration.FinishCapture();
+
+    const stick_calibration_t &params = calibration.GetParams();
+    TEST_ASSERT_FALSE(calibration.Capturing());
+    TEST_ASSERT_EQUAL_UINT8(120, params.center_x);
+    TEST_ASSERT_EQUAL_UINT8(135, params.center_y);
+    TEST_ASSERT_EQUAL_UINT8(40, params.min_x);
+    TEST_ASSERT_EQUAL_UINT8(210, params.max_x);
+    TEST_ASSERT_EQUAL_UINT8(60, params.min_y);
+    TEST_ASSERT_EQUAL_UINT8(200, params.max_y);
+
+    // The captured center and edges map to center and full deflection.
+    uint8_t x = 120;
+    uint8_t y = 135;
+    calibration.Apply(x, y);
+    TEST_ASSERT_EQUAL_UINT8(128, x);
+    TEST_ASSERT_EQUAL_UINT8(128, y);
+
+    x = 210;
+    y = 135;
+    calibration.Apply(x, y);
+    TEST_ASSERT_EQUAL_UINT8(128 + RANGE, x);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_response_is_zero_inside_deadzone);
+    RUN_TEST(test_response_reaches_range_at_edge);
+    RUN_TEST(test_linear_response);
+    RUN_TEST(test_curve_is_a_power_of_distance_past_deadzone);
+    RUN_TEST(test_response_never_decreases);
+    RUN_TEST(test_apply_matches_response_along_axes);
+    RUN_TEST(test_apply_keeps_output_in_range);
+    RUN_TEST(test_capture_takes_center_and_range_from_samples);
+    return UNITY_END();
+}
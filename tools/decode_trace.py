@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""Decodes a poll trace streamed by TraceRecorder (see include/core/TraceRecorder.hpp).
+
+Reads frames from a serial port or a previously captured file, prints one line per recorded poll
+and a summary of poll timing and dropped records at the end. Boot profile frames (see
+include/core/boot_profile.hpp) are skipped unless --boot-profile is given.
+
+Usage:
+    decode_trace.py /dev/ttyACM0            # Decode live from the controller
+    decode_trace.py capture.bin             # Decode a saved capture
+    decode_trace.py /dev/ttyACM0 -o cap.bin # Also save the raw stream for later
+    decode_trace.py cap.bin --c-array trace  # Emit a trace_record_t array for ReplayInput
+"""
+
+import argparse
+import struct
+import sys
+
+FRAME_HEADER = 0xB1
+RECORD_FORMAT = "<HIIbbI6BH6B"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+FRAME_SIZE = RECORD_SIZE + 2
+
+BOOT_PROFILE_HEADER = 0xB2
+# Must match boot_profile::Stage.
+BOOT_STAGES = [
+    "input_init", "console_detect", "backend_init", "mode_init", "first_report", "nunchuk_init",
+    "display_init",
+]
+BOOT_PROFILE_FORMAT = f"<B{len(BOOT_STAGES)}I"
+BOOT_PROFILE_SIZE = struct.calcsize(BOOT_PROFILE_FORMAT)
+BOOT_PROFILE_NOT_MARKED = 0xFFFFFFFF
+
+# Longest frame of any type, so a complete frame is always buffered before it is checked.
+MAX_FRAME_SIZE = max(FRAME_SIZE, BOOT_PROFILE_SIZE + 2)
+
+# Must match input_mask::InputBit.
+INPUT_BITS = [
+    "left", "right", "down", "up", "c_left", "c_right", "c_down", "c_up", "a", "b", "x", "y",
+    "l", "r", "z", "lightshield", "midshield", "select", "start", "home", "mod_x", "mod_y",
+    "nunchuk_connected", "nunchuk_c", "nunchuk_z",
+]
+
+# Must match input_mask::PassthroughBit.
+PASSTHROUGH_BITS = [
+    "connected", "a", "b", "x", "y", "z", "l", "r", "start", "dpad_up", "dpad_down", "dpad_left",
+    "dpad_right",
+]
+
+# Must match OutputBit.
+OUTPUT_BITS = [
+    "a", "b", "x", "y", "buttonL", "buttonR", "triggerLDigital", "triggerRDigital", "start",
+    "select", "home", "dpadUp", "dpadDown", "dpadLeft", "dpadRight", "leftStickClick",
+    "rightStickClick",
+]
+
+
+def mask_names(mask, names):
+    return "+".join(name for i, name in enumerate(names) if mask & (1 << i)) or "-"
+
+
+def checksum_ok(frame):
+    checksum = 0
+    for byte in frame[1:-1]:
+        checksum ^= byte
+    return checksum == frame[-1]
+
+
+def read_frames(stream, raw_out=None):
+    """Yields (header, fields) for each trace record and boot profile frame in the stream."""
+    buffer = bytearray()
+    while True:
+        chunk = stream.read(FRAME_SIZE)
+        if not chunk:
+            return
+        if raw_out is not None:
+            raw_out.write(chunk)
+        buffer += chunk
+        while len(buffer) >= MAX_FRAME_SIZE:
+            if buffer[0] == FRAME_HEADER:
+                record_format, size = RECORD_FORMAT, FRAME_SIZE
+            elif buffer[0] == BOOT_PROFILE_HEADER:
+                record_format, size = BOOT_PROFILE_FORMAT, BOOT_PROFILE_SIZE + 2
+            else:
+                del buffer[0]
+                continue
+            frame = bytes(buffer[:size])
+            if not checksum_ok(frame):
+                # Not actually a frame boundary, resync on the next header byte.
+                del buffer[0]
+                continue
+            del buffer[:size]
+            yield frame[0], struct.unpack(record_format, frame[1:-1])
+
+
+def print_boot_profile(fields):
+    stage_count, *timestamps = fields
+    print("# boot profile (us since reset):", file=sys.stderr)
+    for name, timestamp in zip(BOOT_STAGES[:stage_count], timestamps):
+        value = "-" if timestamp == BOOT_PROFILE_NOT_MARKED else timestamp
+        print(f"#   {name:<16} {value}", file=sys.stderr)
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin.buffer
+    try:
+        import serial
+
+        return serial.Serial(path, baudrate, timeout=None)
+    except (ImportError, ValueError, OSError):
+        return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="serial port, capture file, or - for stdin")
+    parser.add_argument("-o", "--output", help="save the raw stream to this file")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200)
+    parser.add_argument("-q", "--quiet", action="store_true", help="only print the summary")
+    parser.add_argument(
+        "--boot-profile", action="store_true", help="print boot profile frames"
+    )
+    parser.add_argument(
+        "--c-array", metavar="NAME", help="print the records as a C array for ReplayInput"
+    )
+    args = parser.parse_args()
+
+    stream = open_input(args.input, args.baudrate)
+    raw_out = open(args.output, "wb") if args.output else None
+
+    count = 0
+    dropped = 0
+    last_sequence = None
+    last_timestamp = None
+    intervals = []
+
+    if args.c_array:
+        print('#include "core/TraceRecorder.hpp"\n')
+        print(f"const trace_record_t {args.c_array}[] = {{")
+
+    try:
+        for header, record in read_frames(stream, raw_out):
+            if header == BOOT_PROFILE_HEADER:
+                if args.boot_profile:
+                    print_boot_profile(record)
+                continue
+
+            sequence, timestamp, inputs, nunchuk_x, nunchuk_y, outputs, *rest = record
+            analog = rest[:6]
+            passthrough = rest[6]
+            analog_inputs = rest[7:]
+            count += 1
+
+            if args.c_array:
+                print("    { " + ", ".join(str(field) for field in record) + " },")
+
+            if last_sequence is not None:
+                gap = (sequence - last_sequence - 1) & 0xFFFF
+                if gap:
+                    dropped += gap
+                    print(f"# {gap} record(s) dropped", file=sys.stderr)
+            interval = None
+            if last_timestamp is not None:
+                interval = (timestamp - last_timestamp) & 0xFFFFFFFF
+                intervals.append(interval)
+            last_sequence = sequence
+            last_timestamp = timestamp
+
+            if not args.quiet and not args.c_array:
+                print(
+                    f"{sequence:5d} {timestamp:10d}us "
+                    f"{'' if interval is None else f'+{interval}us':>9} "
+                    f"in={mask_names(inputs, INPUT_BITS)} "
+                    f"nunchuk=({nunchuk_x},{nunchuk_y}) "
+                    f"out={mask_names(outputs, OUTPUT_BITS)} "
+                    f"ls=({analog[0]},{analog[1]}) rs=({analog[2]},{analog[3]}) "
+                    f"lt={analog[4]} rt={analog[5]}"
+                    + (
+                        f" gcc={mask_names(passthrough, PASSTHROUGH_BITS)} "
+                        f"ain=({analog_inputs[0]},{analog_inputs[1]}) "
+                        f"({analog_inputs[2]},{analog_inputs[3]}) "
+                        f"{analog_inputs[4]} {analog_inputs[5]}"
+                        if passthrough or analog_inputs[4] or analog_inputs[5]
+                        else ""
+                    )
+                )
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if raw_out is not None:
+            raw_out.close()
+
+    if args.c_array:
+        print("};")
+        print(f"const size_t {args.c_array}_count = {count};")
+
+    print(f"# {count} records, {dropped} dropped", file=sys.stderr)
+    if intervals:
+        mean = sum(intervals) / len(intervals)
+        print(
+            f"# poll interval min={min(intervals)}us max={max(intervals)}us mean={mean:.1f}us",
+            file=sys.stderr,
+        )
+
+
+if __name__ == "__main__":
+    main()
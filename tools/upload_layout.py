@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Uploads a custom input display layout to a Pico controller over USB serial.
+
+The layout is stored in flash and used from the next boot onwards, instead of the layouts selected
+in the config (see HAL/pico/include/display/custom_layout.hpp).
+
+The controller only listens for layouts when nothing else uses the serial port, e.g. in Switch mode
+(hold X while plugging in), not in the XInput or DInput modes, which stream input viewer reports.
+
+A layout file has one button per line: the input name, the shape (circle or square), then x and y.
+Circles are centered on x, y and squares have their top left corner at x, y. Lines starting with #
+are ignored. For example:
+
+    # input     shape   x   y
+    l           circle  6   29
+    left        circle  15  23
+    start       square  61  24
+
+Usage:
+    upload_layout.py layout.txt /dev/ttyACM0
+    upload_layout.py layout.txt --dump       # Print the encoded frame without uploading
+"""
+
+import argparse
+import sys
+
+FRAME_HEADER = 0xD1
+MAX_BUTTONS = 32
+
+# Must match input_mask::InputBit.
+INPUT_BITS = [
+    "left", "right", "down", "up", "c_left", "c_right", "c_down", "c_up", "a", "b", "x", "y",
+    "l", "r", "z", "lightshield", "midshield", "select", "start", "home", "mod_x", "mod_y",
+    "nunchuk_connected", "nunchuk_c", "nunchuk_z",
+]
+
+# Must match ButtonShape.
+SHAPES = ["circle", "square"]
+
+
+def parse_layout(path):
+    buttons = []
+    with open(path) as layout_file:
+        for line_number, line in enumerate(layout_file, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            if len(fields) != 4:
+                raise ValueError(f"{path}:{line_number}: expected 'input shape x y'")
+            name, shape, x, y = fields
+            if name not in INPUT_BITS:
+                raise ValueError(f"{path}:{line_number}: unknown input '{name}'")
+            if shape not in SHAPES:
+                raise ValueError(f"{path}:{line_number}: unknown shape '{shape}'")
+            x, y = int(x), int(y)
+            if not (0 <= x < 128 and 0 <= y < 64):
+                raise ValueError(f"{path}:{line_number}: position out of range")
+            buttons.append((INPUT_BITS.index(name), SHAPES.index(shape), x, y))
+    if len(buttons) > MAX_BUTTONS:
+        raise ValueError(f"{path}: at most {MAX_BUTTONS} buttons are supported")
+    return buttons
+
+
+def encode_frame(buttons):
+    frame = bytearray([FRAME_HEADER, len(buttons)])
+    for button in buttons:
+        frame += bytes(button)
+    checksum = 0
+    for byte in frame:
+        checksum ^= byte
+    frame.append(checksum)
+    return bytes(frame)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("layout", help="layout file")
+    parser.add_argument("port", nargs="?", help="serial port of the controller")
+    parser.add_argument("--dump", action="store_true", help="print the frame instead of sending")
+    args = parser.parse_args()
+
+    try:
+        frame = encode_frame(parse_layout(args.layout))
+    except ValueError as error:
+        sys.exit(str(error))
+
+    if args.dump or args.port is None:
+        print(frame.hex(" "))
+        return
+
+    import serial
+
+    with serial.Serial(args.port, 115200, timeout=1) as port:
+        port.write(frame)
+        port.flush()
+    print(f"Uploaded {frame[1]} buttons. Reconnect the controller to use the new layout.")
+
+
+if __name__ == "__main__":
+    main()